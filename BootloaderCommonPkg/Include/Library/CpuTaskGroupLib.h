@@ -0,0 +1,82 @@
+/** @file
+  Run a group of independent tasks on all available processors.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _CPU_TASK_GROUP_LIB_H_
+#define _CPU_TASK_GROUP_LIB_H_
+
+#include <Guid/MpCpuTaskInfoHob.h>
+
+/**
+  Function to run for one task of a task group.
+
+  @param[in]  TaskIndex   Index of the task, from 0 to TaskCount - 1.
+  @param[in]  Context     Context passed to CpuTaskGroupRun ().
+
+**/
+typedef
+VOID
+(EFIAPI *CPU_GROUP_TASK_FUNC) (
+  IN  UINT32        TaskIndex,
+  IN  VOID         *Context
+  );
+
+/**
+  Run TaskFunc for every task index on the BSP and all ready APs.
+
+  The task indexes are split into one queue per processor. A processor
+  takes tasks from the front of its own queue and, once it is empty,
+  steals half of the largest remaining queue, so uneven tasks still keep
+  all processors busy. The function returns when all tasks completed.
+
+  It must be called on the BSP. The tasks run serially on the caller when
+  no AP is ready, or when it is called again from inside a task.
+
+  @param[in]  SysCpuTask  CPU task slots of the APs, or NULL for BSP only.
+  @param[in]  TaskCount   Number of tasks to run.
+  @param[in]  TaskFunc    Function to run for each task.
+  @param[in]  Context     Context passed to every TaskFunc call.
+
+  @retval EFI_SUCCESS             All tasks completed.
+  @retval EFI_INVALID_PARAMETER   TaskFunc is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+CpuTaskGroupRun (
+  IN  SYS_CPU_TASK          *SysCpuTask   OPTIONAL,
+  IN  UINT32                 TaskCount,
+  IN  CPU_GROUP_TASK_FUNC    TaskFunc,
+  IN  VOID                  *Context
+  );
+
+/**
+  Fill a large buffer with a byte value using the BSP and all ready APs.
+
+  The buffer is split into 2MB chunks that are filled as a task group.
+  Buffers smaller than two chunks are filled on the caller only. The
+  achieved bandwidth is reported in the debug log, at info level for
+  buffers of 64MB or more.
+
+  @param[in]  SysCpuTask  CPU task slots of the APs, or NULL for BSP only.
+  @param[out] Buffer      Buffer to fill.
+  @param[in]  Length      Number of bytes to fill.
+  @param[in]  Value       Value to fill the buffer with.
+
+  @retval     Buffer
+
+**/
+VOID *
+EFIAPI
+CpuTaskGroupSetMem (
+  IN  SYS_CPU_TASK          *SysCpuTask   OPTIONAL,
+  OUT VOID                  *Buffer,
+  IN  UINTN                  Length,
+  IN  UINT8                  Value
+  );
+
+#endif
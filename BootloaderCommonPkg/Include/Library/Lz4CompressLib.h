@@ -87,6 +87,32 @@ Lz4Decompress (
   IN OUT VOID    *Scratch
   );
 
+/**
+  Decompresses a single raw LZ4 block.
+
+  Unlike Lz4Decompress(), the source has no size header. This is the block
+  format used inside LZ4 frames.
+
+  @param[in]  Source           The source buffer containing the compressed block.
+  @param[in]  SourceSize       The size of the compressed block.
+  @param[out] Destination      The destination buffer to store the decompressed data.
+  @param[in]  DestinationSize  The size of the destination buffer.
+  @param[out] DecodedSize      The number of bytes written into Destination.
+
+  @retval  RETURN_SUCCESS            The block was decompressed successfully.
+  @retval  RETURN_INVALID_PARAMETER  The block is corrupted or does not fit
+                                     into the destination buffer.
+**/
+RETURN_STATUS
+EFIAPI
+Lz4DecompressBlock (
+  IN  CONST VOID  *Source,
+  IN  UINT32       SourceSize,
+  OUT VOID        *Destination,
+  IN  UINT32       DestinationSize,
+  OUT UINT32      *DecodedSize
+  );
+
 
 /**
   Given a LZ4 source buffer, this function retrieves the required
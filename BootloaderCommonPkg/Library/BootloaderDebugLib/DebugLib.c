@@ -1,6 +1,6 @@
 /** @file
 
-  Copyright (c) 2014 - 2018, Intel Corporation. All rights reserved.<BR>
+  Copyright (c) 2014 - 2026, Intel Corporation. All rights reserved.<BR>
   SPDX-License-Identifier: BSD-2-Clause-Patent
 
 **/
@@ -17,6 +17,7 @@
 #include <Library/BootloaderCommonLib.h>
 #include <Library/DebugPrintErrorLevelLib.h>
 #include <Library/ConsoleOutLib.h>
+#include <Register/Intel/ArchitecturalMsr.h>
 
 //
 // Define the maximum debug and assert message length that this library supports
@@ -30,6 +31,9 @@
   GetDebugPrintErrorLevel (), then print the message specified by Format and the
   associated variable argument list to the debug output device.
 
+  Messages from APs are dropped, since the debug output devices and the log
+  buffer are not shared safely between processors.
+
   If Format is NULL, then ASSERT().
 
   @param  ErrorLevel  The error level of the debug message.
@@ -46,10 +50,11 @@ DebugPrint (
   ...
   )
 {
-  CHAR8    Buffer[MAX_DEBUG_MESSAGE_LENGTH];
-  VA_LIST  Marker;
-  UINTN    Length;
-  BOOLEAN  OutputToSerial;
+  CHAR8                        Buffer[MAX_DEBUG_MESSAGE_LENGTH];
+  VA_LIST                      Marker;
+  UINTN                        Length;
+  BOOLEAN                      OutputToSerial;
+  MSR_IA32_APIC_BASE_REGISTER  ApicBaseMsr;
 
 
   //
@@ -64,6 +69,11 @@ DebugPrint (
     return;
   }
 
+  ApicBaseMsr.Uint64 = AsmReadMsr64 (MSR_IA32_APIC_BASE);
+  if (ApicBaseMsr.Bits.BSP == 0) {
+    return;
+  }
+
   //
   // Convert the DEBUG() message to an ASCII String
   //
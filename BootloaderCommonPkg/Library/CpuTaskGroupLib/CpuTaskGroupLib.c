@@ -0,0 +1,404 @@
+/** @file
+  Run a group of independent tasks on all available processors.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiPei.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Library/DebugLib.h>
+#include <Library/TimeStampLib.h>
+#include <Library/CpuTaskGroupLib.h>
+
+//
+// Keep every queue in its own cache line, they are updated by different CPUs
+//
+#define CPU_TASK_QUEUE_SIZE            64
+
+#define TASK_RANGE(Next, End)          (LShiftU64 ((End), 32) | (Next))
+#define TASK_RANGE_NEXT(Range)         ((UINT32)(Range))
+#define TASK_RANGE_END(Range)          ((UINT32)RShiftU64 ((Range), 32))
+
+typedef struct {
+  // Low 32 bits: next task index, high 32 bits: end task index
+  volatile UINT64       Range;
+  UINT8                 Reserved[CPU_TASK_QUEUE_SIZE - sizeof (UINT64)];
+} CPU_TASK_QUEUE;
+
+typedef struct {
+  CPU_GROUP_TASK_FUNC   TaskFunc;
+  VOID                 *Context;
+  CPU_TASK_QUEUE       *Queue;
+  UINT32                QueueCount;
+  volatile UINT32       Joined;
+  volatile UINT32       Finished;
+} CPU_TASK_GROUP;
+
+//
+// Large enough for BaseMemoryLib to use non-temporal stores on each chunk
+//
+#define CPU_SET_MEM_CHUNK_SIZE         SIZE_2MB
+
+typedef struct {
+  UINT8                *Buffer;
+  UINTN                 Length;
+  UINT8                 Value;
+} CPU_SET_MEM_JOB;
+
+STATIC CPU_TASK_GROUP * volatile  mActiveGroup;
+STATIC CPU_TASK_QUEUE            *mTaskQueue;
+STATIC UINT32                     mTaskQueueCount;
+
+/**
+  Get the task queues, allocated once and reused by later task groups.
+
+  @param[in]  QueueCount  Number of queues needed.
+
+  @retval     NULL        Not enough memory.
+  @retval     Others      Pointer to QueueCount cache line aligned queues.
+
+**/
+STATIC
+CPU_TASK_QUEUE *
+GetTaskQueues (
+  IN  UINT32             QueueCount
+  )
+{
+  VOID       *Buffer;
+
+  if (QueueCount > mTaskQueueCount) {
+    // Stage2 cannot free pool, so no attempt is made to release the old one
+    Buffer = AllocatePool ((QueueCount + 1) * sizeof (CPU_TASK_QUEUE));
+    if (Buffer == NULL) {
+      return NULL;
+    }
+    mTaskQueue      = ALIGN_POINTER (Buffer, CPU_TASK_QUEUE_SIZE);
+    mTaskQueueCount = QueueCount;
+  }
+
+  return mTaskQueue;
+}
+
+/**
+  Take the next task from the front of a queue.
+
+  @param[in]  Queue       Queue to take the task from.
+  @param[out] TaskIndex   Index of the task taken.
+
+  @retval TRUE            A task was taken.
+  @retval FALSE           The queue is empty.
+
+**/
+STATIC
+BOOLEAN
+TakeTask (
+  IN  CPU_TASK_QUEUE    *Queue,
+  OUT UINT32            *TaskIndex
+  )
+{
+  UINT64      Range;
+  UINT32      Next;
+
+  do {
+    // A torn read on IA32 only makes the compare exchange below fail
+    Range = Queue->Range;
+    Next  = TASK_RANGE_NEXT (Range);
+    if (Next >= TASK_RANGE_END (Range)) {
+      return FALSE;
+    }
+  } while (InterlockedCompareExchange64 (&Queue->Range, Range,
+             TASK_RANGE (Next + 1, TASK_RANGE_END (Range))) != Range);
+
+  *TaskIndex = Next;
+  return TRUE;
+}
+
+/**
+  Move half of the largest other queue into an empty queue.
+
+  @param[in]  Group       Task group.
+  @param[in]  Slot        Queue index of the calling processor.
+
+  @retval TRUE            Tasks were moved into the queue of Slot.
+  @retval FALSE           All queues are empty.
+
+**/
+STATIC
+BOOLEAN
+StealTasks (
+  IN  CPU_TASK_GROUP    *Group,
+  IN  UINT32             Slot
+  )
+{
+  UINT64      Range;
+  UINT64      Own;
+  UINT32      Index;
+  UINT32      Victim;
+  UINT32      Remain;
+  UINT32      Most;
+  UINT32      Half;
+  UINT32      End;
+
+  while (TRUE) {
+    Victim = Slot;
+    Most   = 0;
+    for (Index = 0; Index < Group->QueueCount; Index++) {
+      if (Index == Slot) {
+        continue;
+      }
+      Range  = Group->Queue[Index].Range;
+      Remain = TASK_RANGE_END (Range) - TASK_RANGE_NEXT (Range);
+      if ((TASK_RANGE_NEXT (Range) < TASK_RANGE_END (Range)) && (Remain > Most)) {
+        Most   = Remain;
+        Victim = Index;
+      }
+    }
+    if (Victim == Slot) {
+      return FALSE;
+    }
+
+    // Take the back half, the owner keeps taking from the front
+    Range = Group->Queue[Victim].Range;
+    End   = TASK_RANGE_END (Range);
+    if (TASK_RANGE_NEXT (Range) >= End) {
+      continue;
+    }
+    Half  = (End - TASK_RANGE_NEXT (Range) + 1) / 2;
+    if (InterlockedCompareExchange64 (&Group->Queue[Victim].Range, Range,
+          TASK_RANGE (TASK_RANGE_NEXT (Range), End - Half)) != Range) {
+      continue;
+    }
+
+    do {
+      Own = Group->Queue[Slot].Range;
+    } while (InterlockedCompareExchange64 (&Group->Queue[Slot].Range, Own, TASK_RANGE (End - Half, End)) != Own);
+    return TRUE;
+  }
+}
+
+/**
+  Run tasks of a group until no queue has any left.
+
+  @param[in]  Group       Task group.
+  @param[in]  Slot        Queue index of the calling processor.
+
+**/
+STATIC
+VOID
+RunGroupWorker (
+  IN  CPU_TASK_GROUP    *Group,
+  IN  UINT32             Slot
+  )
+{
+  UINT32      TaskIndex;
+
+  do {
+    while (TakeTask (&Group->Queue[Slot], &TaskIndex)) {
+      Group->TaskFunc (TaskIndex, Group->Context);
+    }
+  } while (StealTasks (Group, Slot));
+}
+
+/**
+  AP task to work on a task group.
+
+  @param[in]  Argument    Pointer to CPU_TASK_GROUP.
+
+  @retval     Always 0.
+
+**/
+STATIC
+UINT64
+EFIAPI
+CpuTaskGroupApTask (
+  IN  UINT64             Argument
+  )
+{
+  CPU_TASK_GROUP  *Group;
+  UINT32           Slot;
+
+  Group = (CPU_TASK_GROUP *)(UINTN)Argument;
+  Slot  = InterlockedIncrement (&Group->Joined);
+  if (Slot < Group->QueueCount) {
+    RunGroupWorker (Group, Slot);
+  }
+  InterlockedIncrement (&Group->Finished);
+
+  return 0;
+}
+
+/**
+  Run TaskFunc for every task index on the BSP and all ready APs.
+
+  The task indexes are split into one queue per processor. A processor
+  takes tasks from the front of its own queue and, once it is empty,
+  steals half of the largest remaining queue, so uneven tasks still keep
+  all processors busy. The function returns when all tasks completed.
+
+  It must be called on the BSP. The tasks run serially on the caller when
+  no AP is ready, or when it is called again from inside a task.
+
+  @param[in]  SysCpuTask  CPU task slots of the APs, or NULL for BSP only.
+  @param[in]  TaskCount   Number of tasks to run.
+  @param[in]  TaskFunc    Function to run for each task.
+  @param[in]  Context     Context passed to every TaskFunc call.
+
+  @retval EFI_SUCCESS             All tasks completed.
+  @retval EFI_INVALID_PARAMETER   TaskFunc is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+CpuTaskGroupRun (
+  IN  SYS_CPU_TASK          *SysCpuTask   OPTIONAL,
+  IN  UINT32                 TaskCount,
+  IN  CPU_GROUP_TASK_FUNC    TaskFunc,
+  IN  VOID                  *Context
+  )
+{
+  CPU_TASK_GROUP   Group;
+  CPU_TASK_QUEUE  *Queue;
+  UINT32           ApCount;
+  UINT32           Started;
+  UINT32           Index;
+  UINT32           Next;
+  UINT32           End;
+
+  if (TaskFunc == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  ApCount = 0;
+  if ((SysCpuTask != NULL) && (mActiveGroup == NULL) && (TaskCount > 1)) {
+    for (Index = 1; Index < SysCpuTask->CpuCount; Index++) {
+      if (SysCpuTask->CpuTask[Index].State == EnumCpuReady) {
+        ApCount++;
+      }
+    }
+    ApCount = MIN (ApCount, TaskCount - 1);
+  }
+
+  Queue = NULL;
+  if (ApCount > 0) {
+    // Size for all CPUs so that the queues are allocated only once
+    Queue = GetTaskQueues (MAX (SysCpuTask->CpuCount, ApCount + 1));
+  }
+  if (Queue == NULL) {
+    for (Index = 0; Index < TaskCount; Index++) {
+      TaskFunc (Index, Context);
+    }
+    return EFI_SUCCESS;
+  }
+
+  ZeroMem (&Group, sizeof (Group));
+  Group.TaskFunc   = TaskFunc;
+  Group.Context    = Context;
+  Group.Queue      = Queue;
+  Group.QueueCount = ApCount + 1;
+  for (Index = 0; Index < Group.QueueCount; Index++) {
+    Next = (UINT32)DivU64x32 (MultU64x32 (TaskCount, Index), Group.QueueCount);
+    End  = (UINT32)DivU64x32 (MultU64x32 (TaskCount, Index + 1), Group.QueueCount);
+    Group.Queue[Index].Range = TASK_RANGE (Next, End);
+  }
+  mActiveGroup = &Group;
+
+  //
+  // Queues of APs that do not join are drained by the other processors
+  //
+  Started = 0;
+  for (Index = 1; (Index < SysCpuTask->CpuCount) && (Started < ApCount); Index++) {
+    if (SysCpuTask->CpuTask[Index].State == EnumCpuReady) {
+      SysCpuTask->CpuTask[Index].TaskFunc = (UINT64)(UINTN)CpuTaskGroupApTask;
+      SysCpuTask->CpuTask[Index].Argument = (UINT64)(UINTN)&Group;
+      *(volatile UINT8 *)&SysCpuTask->CpuTask[Index].State = EnumCpuStart;
+      Started++;
+    }
+  }
+
+  RunGroupWorker (&Group, 0);
+
+  while (Group.Finished < Started) {
+    CpuPause ();
+  }
+
+  mActiveGroup = NULL;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Task group function to fill one chunk of a buffer.
+
+  @param[in]  TaskIndex   Index of the chunk to fill.
+  @param[in]  Context     Pointer to CPU_SET_MEM_JOB.
+
+**/
+STATIC
+VOID
+EFIAPI
+SetMemChunk (
+  IN  UINT32             TaskIndex,
+  IN  VOID              *Context
+  )
+{
+  CPU_SET_MEM_JOB  *Job;
+  UINTN             Offset;
+
+  Job    = (CPU_SET_MEM_JOB *)Context;
+  Offset = (UINTN)TaskIndex * CPU_SET_MEM_CHUNK_SIZE;
+  SetMem (Job->Buffer + Offset, MIN (Job->Length - Offset, CPU_SET_MEM_CHUNK_SIZE), Job->Value);
+}
+
+/**
+  Fill a large buffer with a byte value using the BSP and all ready APs.
+
+  The buffer is split into 2MB chunks that are filled as a task group.
+  Buffers smaller than two chunks are filled on the caller only. The
+  achieved bandwidth is reported in the debug log, at info level for
+  buffers of 64MB or more.
+
+  @param[in]  SysCpuTask  CPU task slots of the APs, or NULL for BSP only.
+  @param[out] Buffer      Buffer to fill.
+  @param[in]  Length      Number of bytes to fill.
+  @param[in]  Value       Value to fill the buffer with.
+
+  @retval     Buffer
+
+**/
+VOID *
+EFIAPI
+CpuTaskGroupSetMem (
+  IN  SYS_CPU_TASK          *SysCpuTask   OPTIONAL,
+  OUT VOID                  *Buffer,
+  IN  UINTN                  Length,
+  IN  UINT8                  Value
+  )
+{
+  CPU_SET_MEM_JOB   Job;
+  UINT64            Start;
+  UINT64            TimeUs;
+  UINT32            ChunkCount;
+
+  if (Length < 2 * CPU_SET_MEM_CHUNK_SIZE) {
+    return SetMem (Buffer, Length, Value);
+  }
+
+  Job.Buffer = (UINT8 *)Buffer;
+  Job.Length = Length;
+  Job.Value  = Value;
+  ChunkCount = (UINT32)((Length + CPU_SET_MEM_CHUNK_SIZE - 1) / CPU_SET_MEM_CHUNK_SIZE);
+
+  Start  = ReadTimeStamp ();
+  CpuTaskGroupRun (SysCpuTask, ChunkCount, SetMemChunk, &Job);
+  TimeUs = MAX (TimeStampTickToMicroSecond (ReadTimeStamp () - Start), 1);
+
+  DEBUG (((Length >= SIZE_64MB) ? DEBUG_INFO : DEBUG_VERBOSE, "Set 0x%lX bytes at 0x%p in %ld us (%ld MB/s)\n", (UINT64)Length, Buffer, TimeUs,
+          DivU64x64Remainder (RShiftU64 (MultU64x32 ((UINT64)Length, 1000000), 20), TimeUs, NULL)));
+
+  return Buffer;
+}
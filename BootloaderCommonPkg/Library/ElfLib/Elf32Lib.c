@@ -69,10 +69,15 @@ RelocateElf32Sections  (
   Elf32_Rel       *Rel32Entry;
   UINT8           *CurPtr;
   UINT32           Index;
-  UINT32           RelIdx;
   UINT32          *Ptr32;
   UINT8            RelType;
   UINTN            Delta;
+  UINT8           *RelPtr;
+  UINT8           *RelEnd;
+  UINTN            RelEntSize;
+  UINTN            ImageStart;
+  UINTN            ImageEnd;
+  UINT32           UnsupportedCount;
 
   Elf32Hdr  = (Elf32_Ehdr *)ElfCt->FileBase;
   if (Elf32Hdr->e_machine != EM_386) {
@@ -87,6 +92,9 @@ RelocateElf32Sections  (
   }
 
   Delta  = (UINTN) ElfCt->ImageAddress - (UINTN) ElfCt->PreferredImageAddress;
+
+  ImageStart = (UINTN)ElfCt->ImageAddress;
+  ImageEnd   = ImageStart + ElfCt->ImageSize;
   CurPtr = ElfCt->FileBase + Elf32Hdr->e_shoff;
   ASSERT(Elf32Hdr->e_shnum < MAX_ELF_SHNUM);
   for (Index = 0; Index < Elf32Hdr->e_shnum; Index++) {
@@ -119,10 +127,18 @@ RelocateElf32Sections  (
         return EFI_INVALID_PARAMETER;
       }
 
-      for (RelIdx = 0; RelIdx < Rel32Shdr->sh_size; RelIdx += Rel32Shdr->sh_entsize) {
-        Rel32Entry = (Elf32_Rel *)((UINT8*)Elf32Hdr + Rel32Shdr->sh_offset + RelIdx);
-        RelType = ELF32_R_TYPE(Rel32Entry->r_info);
-        switch (RelType) {
+      //
+      // Keep the table walk in locals: the fixup stores below may alias the
+      // section header, which would otherwise force a reload every entry.
+      //
+      RelEntSize       = (UINTN)Rel32Shdr->sh_entsize;
+      RelPtr           = (UINT8 *)Elf32Hdr + Rel32Shdr->sh_offset;
+      RelEnd           = RelPtr + Rel32Shdr->sh_size;
+      UnsupportedCount = 0;
+      RelType          = R_386_NONE;
+      for (; RelPtr < RelEnd; RelPtr += RelEntSize) {
+        Rel32Entry = (Elf32_Rel *)RelPtr;
+        switch (ELF32_R_TYPE(Rel32Entry->r_info)) {
           case R_386_NONE:
           case R_386_PC32:
             //
@@ -138,8 +154,7 @@ RelocateElf32Sections  (
             //
             // Sanity check for the relocation address
             //
-            if (((UINTN)Ptr32 < (UINTN)ElfCt->ImageAddress) ||
-                ((UINTN)Ptr32 + sizeof(UINT32) > (UINTN)ElfCt->ImageAddress + ElfCt->ImageSize)) {
+            if (((UINTN)Ptr32 < ImageStart) || ((UINTN)Ptr32 + sizeof(UINT32) > ImageEnd)) {
               DEBUG ((DEBUG_ERROR, "Relocation target out of bounds: 0x%p\n", Ptr32));
               return EFI_LOAD_ERROR;
             }
@@ -147,9 +162,18 @@ RelocateElf32Sections  (
             *Ptr32 += (UINT32) Delta;
             break;
           default:
-            DEBUG ((DEBUG_INFO, "Unsupported relocation type %02X\n", RelType));
+            RelType = (UINT8)ELF32_R_TYPE(Rel32Entry->r_info);
+            UnsupportedCount++;
         }
       }
+
+      //
+      // Report once per section instead of once per entry to keep the
+      // serial log from dominating load time.
+      //
+      if (UnsupportedCount != 0) {
+        DEBUG ((DEBUG_INFO, "Skipped %d unsupported relocations, last type %02X\n", UnsupportedCount, RelType));
+      }
     }
   }
   ElfCt->EntryPoint = (UINTN)(Elf32Hdr->e_entry + Delta);
@@ -69,12 +69,17 @@ RelocateElf64Sections  (
   Elf64_Rel        *Rel64Entry;
   UINT8            *CurPtr;
   UINT32           Index;
-  UINT64           RelIdx;
   UINT32           *Ptr32;
   UINT64           *Ptr64;
   UINT32           RelType;
   UINTN            Delta;
   UINT64           Remainder;
+  UINT8            *RelPtr;
+  UINT8            *RelEnd;
+  UINTN            RelEntSize;
+  UINTN            ImageStart;
+  UINTN            ImageEnd;
+  UINT32           UnsupportedCount;
 
   Elf64Hdr  = (Elf64_Ehdr *)ElfCt->FileBase;
   if (Elf64Hdr->e_machine != EM_X86_64) {
@@ -89,6 +94,9 @@ RelocateElf64Sections  (
   }
 
   Delta  = (UINTN) ElfCt->ImageAddress - (UINTN) ElfCt->PreferredImageAddress;
+
+  ImageStart = (UINTN)ElfCt->ImageAddress;
+  ImageEnd   = ImageStart + ElfCt->ImageSize;
   CurPtr = ElfCt->FileBase + Elf64Hdr->e_shoff;
   ASSERT(Elf64Hdr->e_shnum < MAX_ELF_SHNUM);
   for (Index = 0; Index < Elf64Hdr->e_shnum; Index++) {
@@ -125,10 +133,18 @@ RelocateElf64Sections  (
         return EFI_INVALID_PARAMETER;
       }
 
-      for (RelIdx = 0; RelIdx < Rel64Shdr->sh_size; RelIdx += Rel64Shdr->sh_entsize) {
-        Rel64Entry = (Elf64_Rel *)((UINT8*)Elf64Hdr + Rel64Shdr->sh_offset + RelIdx);
-        RelType = ELF64_R_TYPE(Rel64Entry->r_info);
-        switch (RelType) {
+      //
+      // Keep the table walk in locals: the fixup stores below may alias the
+      // section header, which would otherwise force a reload every entry.
+      //
+      RelEntSize       = (UINTN)Rel64Shdr->sh_entsize;
+      RelPtr           = (UINT8 *)Elf64Hdr + (UINTN)Rel64Shdr->sh_offset;
+      RelEnd           = RelPtr + (UINTN)Rel64Shdr->sh_size;
+      UnsupportedCount = 0;
+      RelType          = R_X86_64_NONE;
+      for (; RelPtr < RelEnd; RelPtr += RelEntSize) {
+        Rel64Entry = (Elf64_Rel *)RelPtr;
+        switch (ELF64_R_TYPE(Rel64Entry->r_info)) {
           case R_X86_64_NONE:
           case R_X86_64_PC32:
           case R_X86_64_PLT32:
@@ -142,8 +158,7 @@ RelocateElf64Sections  (
             //
             // Sanity check for the relocation address
             //
-            if (((UINTN)Ptr64 < (UINTN)ElfCt->ImageAddress) ||
-                ((UINTN)Ptr64 + sizeof(UINT64) > (UINTN)ElfCt->ImageAddress + ElfCt->ImageSize)) {
+            if (((UINTN)Ptr64 < ImageStart) || ((UINTN)Ptr64 + sizeof(UINT64) > ImageEnd)) {
               DEBUG ((DEBUG_ERROR, "Relocation target out of bounds: 0x%p\n", Ptr64));
               return EFI_LOAD_ERROR;
             }
@@ -156,8 +171,7 @@ RelocateElf64Sections  (
             //
             // Sanity check for the relocation address
             //
-            if (((UINTN)Ptr32 < (UINTN)ElfCt->ImageAddress) ||
-                ((UINTN)Ptr32 + sizeof(UINT32) > (UINTN)ElfCt->ImageAddress + ElfCt->ImageSize)) {
+            if (((UINTN)Ptr32 < ImageStart) || ((UINTN)Ptr32 + sizeof(UINT32) > ImageEnd)) {
               DEBUG ((DEBUG_ERROR, "Relocation target out of bounds: 0x%p\n", Ptr32));
               return EFI_LOAD_ERROR;
             }
@@ -165,9 +179,18 @@ RelocateElf64Sections  (
             *Ptr32 += (UINT32)Delta;
             break;
           default:
-            DEBUG ((DEBUG_INFO, "Unsupported relocation type %02X\n", RelType));
+            RelType = ELF64_R_TYPE(Rel64Entry->r_info);
+            UnsupportedCount++;
         }
       }
+
+      //
+      // Report once per section instead of once per entry to keep the
+      // serial log from dominating load time.
+      //
+      if (UnsupportedCount != 0) {
+        DEBUG ((DEBUG_INFO, "Skipped %d unsupported relocations, last type %02X\n", UnsupportedCount, RelType));
+      }
     }
   }
   ElfCt->EntryPoint = (UINTN)(Elf64Hdr->e_entry + Delta);
@@ -1,7 +1,11 @@
 /** @file
   Provide Hob Library functions for Pei phase.
 
-Copyright (c) 2007 - 2017, Intel Corporation. All rights reserved.<BR>
+  GUID HOB lookups on a HOB list that starts with a PHIT HOB use an index
+  of the first HOB of each GUID. The index is extended with the HOBs that
+  were appended since it was built, so it stays valid while HOBs are added.
+
+Copyright (c) 2007 - 2026, Intel Corporation. All rights reserved.<BR>
 SPDX-License-Identifier: BSD-2-Clause-Patent
 
 **/
@@ -9,9 +13,32 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <PiPei.h>
 
 #include <Library/HobLib.h>
+#include <Library/BaseLib.h>
 #include <Library/DebugLib.h>
 #include <Library/BaseMemoryLib.h>
+#include <Library/PcdLib.h>
 #include <Library/BootloaderCommonLib.h>
+#include <Register/Intel/ArchitecturalMsr.h>
+
+//
+// Number of HOB lists indexed at the same time, e.g. the loader and the FSP HOB list
+//
+#define  HOB_INDEX_LIST_COUNT     2
+//
+// Number of GUID slots per HOB list, must be a power of 2
+//
+#define  HOB_INDEX_SLOT_COUNT     128
+
+typedef struct {
+  EFI_HOB_HANDOFF_INFO_TABLE  *HobList;
+  EFI_PHYSICAL_ADDRESS         EndOfHobList;
+  UINT32                       Count;
+  BOOLEAN                      Full;
+  EFI_HOB_GUID_TYPE           *Slot[HOB_INDEX_SLOT_COUNT];
+} HOB_GUID_INDEX;
+
+STATIC HOB_GUID_INDEX  mHobGuidIndex[HOB_INDEX_LIST_COUNT];
+STATIC UINT32          mHobGuidIndexNext;
 
 /**
   Returns the pointer to the HOB list.
@@ -96,6 +123,206 @@ GetFirstHob (
   return GetNextHob (Type, HobList);
 }
 
+/**
+  Get the index slot position of a GUID.
+
+  @param  Index         The HOB GUID index.
+  @param  Guid          The GUID to look up.
+  @param  Position      The slot holding the GUID, or the empty slot to add it to.
+
+  @retval TRUE          The GUID was found in the index.
+  @retval FALSE         The GUID was not found in the index.
+
+**/
+STATIC
+BOOLEAN
+HobIndexFindSlot (
+  IN  HOB_GUID_INDEX        *Index,
+  IN  CONST EFI_GUID        *Guid,
+  OUT UINT32                *Position
+  )
+{
+  UINT32                 Slot;
+  UINT32                 Probe;
+
+  Slot = (Guid->Data1 ^ Guid->Data2 ^ ((UINT32)Guid->Data3 << 16)) & (HOB_INDEX_SLOT_COUNT - 1);
+  for (Probe = 0; Probe < HOB_INDEX_SLOT_COUNT; Probe++) {
+    if ((Index->Slot[Slot] == NULL) || CompareGuid (Guid, &Index->Slot[Slot]->Name)) {
+      break;
+    }
+    Slot = (Slot + 1) & (HOB_INDEX_SLOT_COUNT - 1);
+  }
+
+  *Position = Slot;
+  return (BOOLEAN)((Probe < HOB_INDEX_SLOT_COUNT) && (Index->Slot[Slot] != NULL));
+}
+
+/**
+  Add the GUID HOBs from a HOB to the end of the HOB list into the index.
+
+  Only the first HOB of each GUID is recorded. The index is marked full once
+  three quarters of the slots are used, and new GUIDs are not recorded anymore.
+
+  @param  Index         The HOB GUID index.
+  @param  HobStart      The first HOB to add.
+
+**/
+STATIC
+VOID
+HobIndexAdd (
+  IN  HOB_GUID_INDEX        *Index,
+  IN  CONST VOID            *HobStart
+  )
+{
+  EFI_PEI_HOB_POINTERS   Hob;
+  UINT32                 Slot;
+
+  Hob.Raw = (UINT8 *) HobStart;
+  while ((Hob.Raw = GetNextHob (EFI_HOB_TYPE_GUID_EXTENSION, Hob.Raw)) != NULL) {
+    if (!HobIndexFindSlot (Index, &Hob.Guid->Name, &Slot)) {
+      if (Index->Count < (HOB_INDEX_SLOT_COUNT * 3 / 4)) {
+        Index->Slot[Slot] = Hob.Guid;
+        Index->Count++;
+      } else {
+        Index->Full = TRUE;
+      }
+    }
+    Hob.Raw = GET_NEXT_HOB (Hob);
+  }
+}
+
+/**
+  Get the up-to-date GUID index of the HOB list containing a HOB.
+
+  The index of a HOB list is built on the first lookup from the head of the
+  list. When HOBs were appended after that, as detected from the end of the
+  HOB list in the PHIT HOB, only the new HOBs are added.
+
+  @param  HobStart      The starting HOB of a lookup.
+
+  @retval NULL          HobStart is not in an indexed HOB list.
+  @retval others        The index of the HOB list containing HobStart.
+
+**/
+STATIC
+HOB_GUID_INDEX *
+HobIndexGet (
+  IN  CONST VOID            *HobStart
+  )
+{
+  EFI_HOB_HANDOFF_INFO_TABLE  *HandOffHob;
+  HOB_GUID_INDEX              *Index;
+  UINT32                       Idx;
+
+  for (Idx = 0; Idx < HOB_INDEX_LIST_COUNT; Idx++) {
+    Index = &mHobGuidIndex[Idx];
+    if ((Index->HobList != NULL) && ((UINTN)HobStart >= (UINTN)Index->HobList) &&
+        ((UINTN)HobStart <= (UINTN)Index->HobList->EfiEndOfHobList)) {
+      break;
+    }
+  }
+
+  if (Idx == HOB_INDEX_LIST_COUNT) {
+    //
+    // Only a lookup from the head of a HOB list can start a new index
+    //
+    HandOffHob = (EFI_HOB_HANDOFF_INFO_TABLE *) HobStart;
+    if (HandOffHob->Header.HobType != EFI_HOB_TYPE_HANDOFF) {
+      return NULL;
+    }
+    Index = &mHobGuidIndex[mHobGuidIndexNext];
+    mHobGuidIndexNext = (mHobGuidIndexNext + 1) % HOB_INDEX_LIST_COUNT;
+    ZeroMem (Index, sizeof (HOB_GUID_INDEX));
+    Index->HobList      = HandOffHob;
+    Index->EndOfHobList = HandOffHob->EfiEndOfHobList;
+    HobIndexAdd (Index, HandOffHob);
+  } else if (Index->EndOfHobList != Index->HobList->EfiEndOfHobList) {
+    if (Index->EndOfHobList < Index->HobList->EfiEndOfHobList) {
+      //
+      // New HOBs were created at the previous end of the HOB list
+      //
+      HobIndexAdd (Index, (VOID *)(UINTN)Index->EndOfHobList);
+    } else {
+      HandOffHob = Index->HobList;
+      ZeroMem (Index, sizeof (HOB_GUID_INDEX));
+      Index->HobList = HandOffHob;
+      HobIndexAdd (Index, HandOffHob);
+    }
+    Index->EndOfHobList = Index->HobList->EfiEndOfHobList;
+  }
+
+  return Index;
+}
+
+/**
+  Look up the next GUID HOB from the starting HOB using the HOB GUID index.
+
+  @param  Guid          The GUID to match with in the HOB list.
+  @param  HobStart      The starting HOB pointer to search from.
+  @param  GuidHob       The matched GUID HOB, or NULL if there is none.
+
+  @retval TRUE          GuidHob holds the lookup result.
+  @retval FALSE         The index cannot answer, the HOB list must be searched.
+
+**/
+STATIC
+BOOLEAN
+HobIndexLookup (
+  IN  CONST EFI_GUID        *Guid,
+  IN  CONST VOID            *HobStart,
+  OUT VOID                  **GuidHob
+  )
+{
+  MSR_IA32_APIC_BASE_REGISTER  ApicBaseMsr;
+  HOB_GUID_INDEX               *Index;
+  EFI_HOB_GUID_TYPE            *Hob;
+  UINT32                       Slot;
+
+  if (HobStart == NULL) {
+    return FALSE;
+  }
+
+  //
+  // The index is not locked, so only the BSP uses it. APs search the HOB list.
+  //
+  ApicBaseMsr.Uint64 = AsmReadMsr64 (MSR_IA32_APIC_BASE);
+  if (ApicBaseMsr.Bits.BSP == 0) {
+    return FALSE;
+  }
+
+  Index = HobIndexGet (HobStart);
+  if (Index == NULL) {
+    return FALSE;
+  }
+
+  if (!HobIndexFindSlot (Index, Guid, &Slot)) {
+    if (Index->Full) {
+      return FALSE;
+    }
+    *GuidHob = NULL;
+    return TRUE;
+  }
+
+  //
+  // Later instances after HobStart are not indexed
+  //
+  Hob = Index->Slot[Slot];
+  if ((UINTN)HobStart > (UINTN)Hob) {
+    return FALSE;
+  }
+
+  if ((Hob->Header.HobType != EFI_HOB_TYPE_GUID_EXTENSION) || !CompareGuid (Guid, &Hob->Name)) {
+    //
+    // The HOB was changed in place, rebuild the index on the next lookup
+    //
+    Index->HobList = NULL;
+    return FALSE;
+  }
+
+  *GuidHob = Hob;
+  return TRUE;
+}
+
 /**
   Returns the next instance of the matched GUID HOB from the starting HOB.
 
@@ -127,6 +354,12 @@ GetNextGuidHob (
 {
   EFI_PEI_HOB_POINTERS  GuidHob;
 
+  if (FeaturePcdGet (PcdHobIndexEnabled)) {
+    if (HobIndexLookup (Guid, HobStart, (VOID **)&GuidHob.Raw)) {
+      return GuidHob.Raw;
+    }
+  }
+
   GuidHob.Raw = (UINT8 *) HobStart;
   while ((GuidHob.Raw = GetNextHob (EFI_HOB_TYPE_GUID_EXTENSION, GuidHob.Raw)) != NULL) {
     if (CompareGuid (Guid, &GuidHob.Guid->Name)) {
@@ -142,7 +142,8 @@ PeCoffRelocateImage (
   UINT32                         *DataPtr;
   UINT16                          Offset;
   UINT16                          TypeOffset;
-  UINT32                          ImgOffset;
+  UINTN                           Count;
+  UINT8                          *PageBase;
   UINT32                          Adjust;
   EFI_TE_IMAGE_HEADER            *Te;
   EFI_IMAGE_NT_HEADERS32         *Pe32;
@@ -202,6 +203,15 @@ PeCoffRelocateImage (
     return RETURN_UNSUPPORTED;
   }
 
+  //
+  // The build tools rebase images to their final address, so most images
+  // are already in place and need no fixup at all.
+  //
+  if (FixupDelta == 0) {
+    PeCoffFindAndReportImageInfo (ImageBase);
+    return RETURN_SUCCESS;
+  }
+
   // This seems to be a bug in the way MS generates the reloc fixup blocks.
   // After we have gone thru all the fixup blocks in the .reloc section, the
   // variable RelocSectionSize should ideally go to zero. But I have found some orphan
@@ -223,21 +233,20 @@ PeCoffRelocateImage (
       return RETURN_UNSUPPORTED;
     }
 
-    RelocSectionSize -= sizeof (UINT32) * 2;
-
     // Extract the correct number of Type/Offset entries. This is given by:
     // Loop count = Number of relocation items =
     // (Block Size - 4 bytes (Page RVA field) - 4 bytes (Block Size field)) divided
     // by 2 (each Type/Offset entry takes 2 bytes).
-    DEBUG ((DEBUG_VERBOSE, "LoopCount = %04x\n", ((BlockSize - 2 * sizeof(UINT32)) / sizeof(UINT16))));
-    for (Index = 0; Index < ((BlockSize - 2 * sizeof (UINT32)) / sizeof (UINT16)); Index++) {
-      TypeOffset = *RelocDataPtr++;
-      Type   = (UINT8) ((TypeOffset & 0xf000) >> 12);
-      Offset = (UINT16) ((UINT16)TypeOffset & 0x0fff);
-      RelocSectionSize -= sizeof (UINT16);
-      ImgOffset = PageRva + Offset - Adjust;
-      DEBUG ((DEBUG_VERBOSE, "%d: PageRva: %08x Offset: %04x Type: %x \n", Index, PageRva, ImgOffset, Type));
-      DataPtr = (UINT32 *)(UINTN)(ImageBase + ImgOffset);
+    Count = (BlockSize - 2 * sizeof (UINT32)) / sizeof (UINT16);
+    RelocSectionSize -= (UINT32)(sizeof (UINT32) * 2 + Count * sizeof (UINT16));
+    DEBUG ((DEBUG_VERBOSE, "LoopCount = %04x\n", Count));
+
+    PageBase = (UINT8 *)(UINTN)(ImageBase + PageRva - Adjust);
+    for (Index = 0; Index < Count; Index++) {
+      TypeOffset = RelocDataPtr[Index];
+      Type    = (UINT8) ((TypeOffset & 0xf000) >> 12);
+      Offset  = (UINT16) ((UINT16)TypeOffset & 0x0fff);
+      DataPtr = (UINT32 *)(PageBase + Offset);
       switch (Type) {
       case 0:
         break;
@@ -258,6 +267,7 @@ PeCoffRelocateImage (
         break;
       }
     }
+    RelocDataPtr += Count;
   }
 
   if (Te != NULL) {
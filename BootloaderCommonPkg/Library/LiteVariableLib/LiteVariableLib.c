@@ -1,7 +1,7 @@
 /** @file
 Lite variable service library
 
-Copyright (c) 2006 - 2023, Intel Corporation. All rights reserved.<BR>
+Copyright (c) 2006 - 2026, Intel Corporation. All rights reserved.<BR>
 Portions copyright (c) 2008 - 2009, Apple Inc. All rights reserved.<BR>
 SPDX-License-Identifier: BSD-2-Clause-Patent
 
@@ -153,6 +153,33 @@ WriteVariableStore (
   return Status;
 }
 
+/**
+  Check if a variable store region is blank.
+
+  @param[in]  Buffer      Region base.
+  @param[in]  Length      Region size.
+
+  @retval     TRUE        All bytes in the region are 0xFF.
+  @retval     FALSE       The region has been programmed.
+**/
+STATIC
+BOOLEAN
+IsVariableStoreBlank (
+  IN UINT8    *Buffer,
+  IN UINT32    Length
+  )
+{
+  UINT32    Idx;
+
+  for (Idx = 0; Idx < Length; Idx++) {
+    if (Buffer[Idx] != 0xFF) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
 /**
 
   This function checks fi the variable store is valid.
@@ -321,6 +348,304 @@ InitializeVariableStore (
   return EFI_SUCCESS;
 }
 
+/**
+  Calculate the index hash for a variable name and GUID.
+
+  @param[in]  VariableName    Variable name.
+  @param[in]  VariableGuid    Variable GUID.
+
+  @retval     Hash value.
+**/
+STATIC
+UINT32
+GetVariableHash (
+  IN  CONST CHAR16    *VariableName,
+  IN  CONST EFI_GUID  *VariableGuid
+  )
+{
+  UINT32    Hash;
+
+  // FNV-1a over the name characters
+  Hash = 0x811C9DC5;
+  while (*VariableName != 0) {
+    Hash = (Hash ^ *VariableName) * 0x01000193;
+    VariableName++;
+  }
+
+  return Hash ^ ReadUnaligned32 ((CONST UINT32 *)VariableGuid);
+}
+
+/**
+  Check if a variable header holds the given variable.
+
+  @param[in]  VarHdrPtr       Variable header pointer.
+  @param[in]  VariableName    Variable name.
+  @param[in]  VariableGuid    Variable GUID.
+
+  @retval     TRUE            The header matches the name and GUID.
+  @retval     FALSE           The header does not match.
+**/
+STATIC
+BOOLEAN
+IsVariableMatch (
+  IN  VARIABLE_HEADER  *VarHdrPtr,
+  IN  CONST CHAR16     *VariableName,
+  IN  CONST EFI_GUID   *VariableGuid
+  )
+{
+  return (BOOLEAN)((StrCmp ((VOID *)&VarHdrPtr[1], VariableName) == 0) &&
+                   CompareGuid (VariableGuid, &VarHdrPtr->VariableGuid));
+}
+
+/**
+  Find the index slot of a variable.
+
+  The index is a hash table with linear probing. The search starts at the
+  home slot of the hash and stops at the matching entry or at the first
+  empty slot.
+
+  @param[in]  VarInstance     Variable instance.
+  @param[in]  Hash            Variable hash.
+  @param[in]  VariableName    Variable name.
+  @param[in]  VariableGuid    Variable GUID.
+
+  @retval     Slot of the variable, or the empty slot it would be added to.
+**/
+STATIC
+UINT32
+FindVariableIndexSlot (
+  IN  VARIABLE_INSTANCE  *VarInstance,
+  IN  UINT32              Hash,
+  IN  CONST CHAR16       *VariableName,
+  IN  CONST EFI_GUID     *VariableGuid
+  )
+{
+  UINT32           Slot;
+  VARIABLE_HEADER *VarHdrPtr;
+
+  Slot = Hash & (VARIABLE_INDEX_SLOTS - 1);
+  while (VarInstance->Index[Slot].Offset != 0) {
+    if (VarInstance->Index[Slot].Hash == Hash) {
+      VarHdrPtr = (VARIABLE_HEADER *)(UINTN)(VarInstance->StoreBase + VarInstance->Index[Slot].Offset);
+      if (IsVariableMatch (VarHdrPtr, VariableName, VariableGuid)) {
+        break;
+      }
+    }
+    Slot = (Slot + 1) & (VARIABLE_INDEX_SLOTS - 1);
+  }
+
+  return Slot;
+}
+
+/**
+  Remove an entry from the index.
+
+  The following entries of the probe sequence are moved back so that no
+  lookup stops early at the freed slot.
+
+  @param[in]  VarInstance     Variable instance.
+  @param[in]  Slot            Slot of the entry to remove.
+**/
+STATIC
+VOID
+RemoveVariableIndexSlot (
+  IN  VARIABLE_INSTANCE  *VarInstance,
+  IN  UINT32              Slot
+  )
+{
+  UINT32    Next;
+  UINT32    Home;
+
+  Next = Slot;
+  while (TRUE) {
+    Next = (Next + 1) & (VARIABLE_INDEX_SLOTS - 1);
+    if (VarInstance->Index[Next].Offset == 0) {
+      break;
+    }
+
+    //
+    // Move the entry back unless its home slot lies cyclically in (Slot, Next]
+    //
+    Home = VarInstance->Index[Next].Hash & (VARIABLE_INDEX_SLOTS - 1);
+    if (((Next - Home) & (VARIABLE_INDEX_SLOTS - 1)) >= ((Next - Slot) & (VARIABLE_INDEX_SLOTS - 1))) {
+      VarInstance->Index[Slot] = VarInstance->Index[Next];
+      Slot = Next;
+    }
+  }
+
+  VarInstance->Index[Slot].Hash   = 0;
+  VarInstance->Index[Slot].Offset = 0;
+  VarInstance->IndexCount--;
+}
+
+/**
+  Add, move or remove a variable in the in-RAM index.
+
+  @param[in]  VarInstance     Variable instance.
+  @param[in]  VariableName    Variable name.
+  @param[in]  VariableGuid    Variable GUID.
+  @param[in]  VarHdrPtr       New variable header, or NULL to remove the variable.
+**/
+STATIC
+VOID
+UpdateVariableIndex (
+  IN  VARIABLE_INSTANCE  *VarInstance,
+  IN  CONST CHAR16       *VariableName,
+  IN  CONST EFI_GUID     *VariableGuid,
+  IN  VARIABLE_HEADER    *VarHdrPtr OPTIONAL
+  )
+{
+  UINT32    Hash;
+  UINT32    Slot;
+
+  if (VarInstance->IndexState == VARIABLE_INDEX_NONE) {
+    return;
+  }
+
+  Hash = GetVariableHash (VariableName, VariableGuid);
+  Slot = FindVariableIndexSlot (VarInstance, Hash, VariableName, VariableGuid);
+  if (VarHdrPtr == NULL) {
+    if (VarInstance->Index[Slot].Offset != 0) {
+      RemoveVariableIndexSlot (VarInstance, Slot);
+    }
+    return;
+  }
+
+  if (VarInstance->Index[Slot].Offset == 0) {
+    if (VarInstance->IndexCount == VARIABLE_INDEX_MAX_ENTRIES) {
+      VarInstance->IndexState = VARIABLE_INDEX_PARTIAL;
+      return;
+    }
+    VarInstance->IndexCount++;
+  }
+  VarInstance->Index[Slot].Hash   = Hash;
+  VarInstance->Index[Slot].Offset = (UINT32)((UINTN)VarHdrPtr - VarInstance->StoreBase);
+}
+
+/**
+  Build the in-RAM variable index from the active variable store.
+
+  The index resolves duplicated variables the same way a store scan does:
+  the first copy not in migration wins, otherwise the last copy is used.
+
+  @param[in]  VarInstance     Variable instance.
+  @param[in]  VarStoreHdrPtr  Active variable store header pointer.
+**/
+STATIC
+VOID
+BuildVariableIndex (
+  IN  VARIABLE_INSTANCE      *VarInstance,
+  IN  VARIABLE_STORE_HEADER  *VarStoreHdrPtr
+  )
+{
+  VARIABLE_HEADER        *VarHdrPtr;
+  VARIABLE_HEADER        *IdxHdrPtr;
+  UINT8                  *VarEndPtr;
+  UINT8                   State;
+  CHAR16                 *VarName;
+  UINT32                  Hash;
+  UINT32                  Slot;
+
+  VarInstance->IndexState = VARIABLE_INDEX_COMPLETE;
+  VarInstance->IndexCount = 0;
+  ZeroMem (VarInstance->Index, sizeof (VarInstance->Index));
+
+  VarHdrPtr = (VARIABLE_HEADER *)&VarStoreHdrPtr[1];
+  VarEndPtr = (UINT8 *)VarStoreHdrPtr + VarStoreHdrPtr->Size;
+  while ((UINT8 *)VarHdrPtr < VarEndPtr) {
+    State = VarHdrPtr->State;
+    if (!IS_HEADER_VALID (State)) {
+      break;
+    }
+
+    if (VarHdrPtr->StartId != VARIABLE_DATA) {
+      // Corrupted store, always fall back to scanning
+      VarInstance->IndexState = VARIABLE_INDEX_NONE;
+      return;
+    }
+
+    if (IS_DATA_VALID (State) && !IS_DELETED (State)) {
+      VarName = (CHAR16 *)&VarHdrPtr[1];
+      Hash    = GetVariableHash (VarName, &VarHdrPtr->VariableGuid);
+      Slot    = FindVariableIndexSlot (VarInstance, Hash, VarName, &VarHdrPtr->VariableGuid);
+      if (VarInstance->Index[Slot].Offset != 0) {
+        IdxHdrPtr = (VARIABLE_HEADER *)(UINTN)(VarInstance->StoreBase + VarInstance->Index[Slot].Offset);
+        if (IS_IN_MIGRATION (IdxHdrPtr->State)) {
+          VarInstance->Index[Slot].Offset = (UINT32)((UINTN)VarHdrPtr - VarInstance->StoreBase);
+        }
+      } else if (VarInstance->IndexCount < VARIABLE_INDEX_MAX_ENTRIES) {
+        VarInstance->Index[Slot].Hash   = Hash;
+        VarInstance->Index[Slot].Offset = (UINT32)((UINTN)VarHdrPtr - VarInstance->StoreBase);
+        VarInstance->IndexCount++;
+      } else {
+        VarInstance->IndexState = VARIABLE_INDEX_PARTIAL;
+      }
+    }
+
+    VarHdrPtr = (VARIABLE_HEADER *) ((UINT8 *)&VarHdrPtr[1] + VarHdrPtr->DataSize);
+  }
+}
+
+/**
+  Look up a variable in the in-RAM index.
+
+  @param[in]  VarStoreHdrPtr  Active variable store header pointer.
+  @param[in]  VariableName    Variable name.
+  @param[in]  VariableGuid    Variable GUID.
+  @param[out] VarHdrPtr       Variable header pointer if found.
+
+  @retval     EFI_SUCCESS     The variable was found.
+  @retval     EFI_NOT_FOUND   The variable does not exist.
+  @retval     EFI_NOT_READY   The index cannot answer, the store needs to be scanned.
+**/
+STATIC
+EFI_STATUS
+LookupVariableIndex (
+  IN  VARIABLE_STORE_HEADER  *VarStoreHdrPtr,
+  IN  CONST CHAR16           *VariableName,
+  IN  CONST EFI_GUID         *VariableGuid,
+  OUT VARIABLE_HEADER       **VarHdrPtr
+  )
+{
+  VARIABLE_INSTANCE  *VarInstance;
+  VARIABLE_HEADER    *FindVarHdrPtr;
+  UINT32              Slot;
+  UINT8               State;
+
+  VarInstance = GetVariableInstance ();
+  if (VarInstance == NULL) {
+    return EFI_NOT_READY;
+  }
+
+  if (VarInstance->IndexState == VARIABLE_INDEX_NONE) {
+    BuildVariableIndex (VarInstance, VarStoreHdrPtr);
+    if (VarInstance->IndexState == VARIABLE_INDEX_NONE) {
+      return EFI_NOT_READY;
+    }
+  }
+
+  Slot = FindVariableIndexSlot (VarInstance, GetVariableHash (VariableName, VariableGuid), VariableName, VariableGuid);
+  if (VarInstance->Index[Slot].Offset == 0) {
+    return (VarInstance->IndexState == VARIABLE_INDEX_COMPLETE) ? EFI_NOT_FOUND : EFI_NOT_READY;
+  }
+
+  //
+  // Make sure the entry still describes a live variable in the active store
+  //
+  FindVarHdrPtr = (VARIABLE_HEADER *)(UINTN)(VarInstance->StoreBase + VarInstance->Index[Slot].Offset);
+  State = FindVarHdrPtr->State;
+  if (((UINT8 *)FindVarHdrPtr < (UINT8 *)&VarStoreHdrPtr[1]) ||
+      ((UINT8 *)FindVarHdrPtr >= (UINT8 *)VarStoreHdrPtr + VarStoreHdrPtr->Size) ||
+      (FindVarHdrPtr->StartId != VARIABLE_DATA) ||
+      !IS_HEADER_VALID (State) || !IS_DATA_VALID (State) || IS_DELETED (State)) {
+    VarInstance->IndexState = VARIABLE_INDEX_NONE;
+    return EFI_NOT_READY;
+  }
+
+  *VarHdrPtr = FindVarHdrPtr;
+  return EFI_SUCCESS;
+}
+
 /**
 
   This internal function finds variable in storage blocks.
@@ -366,6 +691,7 @@ InternalGetVariable (
   UINT32                  VariableDataLen;
   UINTN                   DataSizeIn;
   EFI_GUID                *VarGuid;
+  EFI_STATUS              Status;
 
   if ((DataSize == NULL) || (VariableName == NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -386,6 +712,14 @@ InternalGetVariable (
   VarEndPtr = (UINT8 *)VarStoreHdrPtr + VarStoreHdrPtr->Size;
 
   FindVarHdrPtr = NULL;
+  Status = LookupVariableIndex (VarStoreHdrPtr, VariableName, VarGuid, &FindVarHdrPtr);
+  if (Status == EFI_NOT_FOUND) {
+    return EFI_NOT_FOUND;
+  } else if (Status == EFI_SUCCESS) {
+    // Skip the store scan
+    VarEndPtr = (UINT8 *)VarHdrPtr;
+  }
+
   while ((UINT8 *)VarHdrPtr < VarEndPtr) {
     State = VarHdrPtr->State;
     if (!IS_HEADER_VALID (State)) {
@@ -583,10 +917,309 @@ GetNextVariableName (
 
 }
 
+/**
+  Check if a variable store holds an interrupted reclaim.
+
+  Reclaim writes the new store header first and only marks it valid once
+  all blocks are complete, so a store with a signature but no valid header
+  is a reclaim target whose progress is kept in ReclaimMap.
+
+  @param[in]  VarStoreHdrPtr  Variable store header pointer.
+  @param[in]  VarStoreLen     Size of one variable store.
+
+  @retval     TRUE            The store holds an interrupted reclaim.
+  @retval     FALSE           No reclaim is in progress on the store.
+**/
+STATIC
+BOOLEAN
+IsReclaimInProgress (
+  IN VARIABLE_STORE_HEADER  *VarStoreHdrPtr,
+  IN UINT32                  VarStoreLen
+  )
+{
+  return (BOOLEAN)((VarStoreHdrPtr->Signature == VARIABLE_STORE_SIGNATURE) &&
+                   (VarStoreHdrPtr->Size == VarStoreLen) &&
+                   (VarStoreHdrPtr->State == 0xFF));
+}
+
+/**
+  Check if Reclaim has completed a block of the new store.
+
+  @param[in]  VarStoreHdrPtr  New variable store header pointer.
+  @param[in]  Block           Block number in the store.
+
+  @retval     TRUE            The block is complete.
+  @retval     FALSE           The block still needs to be written.
+**/
+STATIC
+BOOLEAN
+IsReclaimBlockDone (
+  IN VARIABLE_STORE_HEADER  *VarStoreHdrPtr,
+  IN UINT32                  Block
+  )
+{
+  if (Block >= VARIABLE_RECLAIM_MAP_BLOCKS) {
+    return FALSE;
+  }
+
+  return (BOOLEAN)((VarStoreHdrPtr->ReclaimMap[Block >> 3] & (1 << (Block & 7))) == 0);
+}
+
+/**
+  Finish a block of the new store.
+
+  A block that is not complete yet is marked complete in the store header.
+  A block completed before a reset is checked to be blank past the end of
+  the copied data instead.
+
+  @param[in]  VarStoreHdrPtr  New variable store header pointer.
+  @param[in]  Block           Block number in the store.
+  @param[in]  EndPtr          End of the copied data.
+
+  @retval     EFI_SUCCESS     The block is complete.
+  @retval     EFI_ABORTED     A completed block does not match, restart the reclaim.
+              Others          Write operation failed.
+**/
+STATIC
+EFI_STATUS
+FinishReclaimBlock (
+  IN VARIABLE_STORE_HEADER  *VarStoreHdrPtr,
+  IN UINT32                  Block,
+  IN UINT8                  *EndPtr
+  )
+{
+  UINT8     *BlockPtr;
+  UINT8      Map;
+
+  BlockPtr = (UINT8 *)VarStoreHdrPtr + Block * VARIABLE_BLOCK_SIZE;
+  if (EndPtr < BlockPtr) {
+    EndPtr = BlockPtr;
+  }
+
+  if (IsReclaimBlockDone (VarStoreHdrPtr, Block)) {
+    if (!IsVariableStoreBlank (EndPtr, (UINT32)(BlockPtr + VARIABLE_BLOCK_SIZE - EndPtr))) {
+      return EFI_ABORTED;
+    }
+    return EFI_SUCCESS;
+  }
+
+  if (Block >= VARIABLE_RECLAIM_MAP_BLOCKS) {
+    return EFI_SUCCESS;
+  }
+
+  Map = VarStoreHdrPtr->ReclaimMap[Block >> 3] & ~(1 << (Block & 7));
+  return WriteVariableStore (&VarStoreHdrPtr->ReclaimMap[Block >> 3], sizeof (Map), &Map);
+}
+
+/**
+  Start a block of the new store.
+
+  A block that is not complete yet is erased unless it is blank already.
+
+  @param[in]  VarStoreHdrPtr  New variable store header pointer.
+  @param[in]  Block           Block number in the store.
+
+  @retval     EFI_SUCCESS     The block is ready to be written.
+              Others          Erasing operation failed.
+**/
+STATIC
+EFI_STATUS
+StartReclaimBlock (
+  IN VARIABLE_STORE_HEADER  *VarStoreHdrPtr,
+  IN UINT32                  Block
+  )
+{
+  UINT8     *BlockPtr;
+
+  if (IsReclaimBlockDone (VarStoreHdrPtr, Block)) {
+    return EFI_SUCCESS;
+  }
+
+  BlockPtr = (UINT8 *)VarStoreHdrPtr + Block * VARIABLE_BLOCK_SIZE;
+  if (IsVariableStoreBlank (BlockPtr, VARIABLE_BLOCK_SIZE)) {
+    return EFI_SUCCESS;
+  }
+
+  return EraseVariableStore (BlockPtr, VARIABLE_BLOCK_SIZE);
+}
+
+/**
+  Copy data into the new store one block at a time.
+
+  Data falling into a block completed before a reset is compared instead of
+  written. Each block is finished once the data reaches its end, and the
+  next block is started.
+
+  @param[in]      VarStoreHdrPtr  New variable store header pointer.
+  @param[in, out] CurPtr          Write position, updated past the data.
+  @param[in]      Buffer          Data to copy.
+  @param[in]      Length          Data length.
+
+  @retval         EFI_SUCCESS     The data was copied.
+  @retval         EFI_ABORTED     A completed block does not match, restart the reclaim.
+                  Others          Flash operation failed.
+**/
+STATIC
+EFI_STATUS
+ReclaimWrite (
+  IN     VARIABLE_STORE_HEADER  *VarStoreHdrPtr,
+  IN OUT UINT8                 **CurPtr,
+  IN     UINT8                  *Buffer,
+  IN     UINT32                  Length
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      Offset;
+  UINT32      Block;
+  UINT32      Size;
+
+  while (Length > 0) {
+    Offset = (UINT32)(*CurPtr - (UINT8 *)VarStoreHdrPtr);
+    Block  = Offset / VARIABLE_BLOCK_SIZE;
+    Size   = MIN (Length, VARIABLE_BLOCK_SIZE - (Offset % VARIABLE_BLOCK_SIZE));
+    if (IsReclaimBlockDone (VarStoreHdrPtr, Block)) {
+      if (CompareMem (*CurPtr, Buffer, Size) != 0) {
+        return EFI_ABORTED;
+      }
+    } else {
+      Status = WriteVariableStore (*CurPtr, Size, Buffer);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+    }
+
+    *CurPtr += Size;
+    Buffer  += Size;
+    Length  -= Size;
+
+    if (((Offset + Size) % VARIABLE_BLOCK_SIZE) == 0) {
+      Status = FinishReclaimBlock (VarStoreHdrPtr, Block, *CurPtr);
+      if (!EFI_ERROR (Status) && ((Block + 1) * VARIABLE_BLOCK_SIZE < VarStoreHdrPtr->Size)) {
+        Status = StartReclaimBlock (VarStoreHdrPtr, Block + 1);
+      }
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Copy the live variables into the new store block by block.
+
+  A new reclaim erases the first block and writes the new store header with
+  all ReclaimMap bits set. Every block is then written in order and its bit
+  is cleared once it is complete, including the blocks of the free area,
+  which are left erased. A resumed reclaim starts from the same active
+  store, so it compares the completed blocks and writes the others.
+
+  @param[in]  ActiveVarStoreHdrPtr    Active variable store header pointer.
+  @param[in]  VarStoreHdrPtr          New variable store header pointer.
+  @param[in]  Resume                  TRUE to resume an interrupted reclaim.
+
+  @retval     EFI_SUCCESS     All blocks of the new store are complete.
+  @retval     EFI_ABORTED     A completed block does not match, restart the reclaim.
+              Others          Flash operation failed.
+**/
+STATIC
+EFI_STATUS
+ReclaimCopy (
+  IN VARIABLE_STORE_HEADER  *ActiveVarStoreHdrPtr,
+  IN VARIABLE_STORE_HEADER  *VarStoreHdrPtr,
+  IN BOOLEAN                 Resume
+  )
+{
+  EFI_STATUS              Status;
+  VARIABLE_STORE_HEADER   VarStoreHdr;
+  VARIABLE_HEADER        *VarHdrPtr;
+  VARIABLE_HEADER        *FindVarHdrPtr;
+  VARIABLE_HEADER         VarHdr;
+  UINT8                  *CurPtr;
+  UINT8                  *ActiveEndPtr;
+  UINTN                   DataLen;
+  UINT32                  Block;
+  UINT8                   State;
+
+  if (!Resume || !IsReclaimBlockDone (VarStoreHdrPtr, 0)) {
+    //
+    // Start over, only the first block is erased here to write the header
+    //
+    Status = EraseVariableStore (VarStoreHdrPtr, VARIABLE_BLOCK_SIZE);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    CopyMem (&VarStoreHdr, ActiveVarStoreHdrPtr, sizeof (VarStoreHdr));
+    VarStoreHdr.State = 0xFF;
+    SetMem (VarStoreHdr.ReclaimMap, sizeof (VarStoreHdr.ReclaimMap), 0xFF);
+    Status = WriteVariableStore (VarStoreHdrPtr, sizeof (VarStoreHdr), (VOID *)&VarStoreHdr);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  //
+  // Copy the live copy of each variable over one by one
+  //
+  CurPtr = (UINT8 *) (VarStoreHdrPtr + 1);
+  VarHdrPtr = (VARIABLE_HEADER *)&ActiveVarStoreHdrPtr[1];
+  ActiveEndPtr = (UINT8 *)ActiveVarStoreHdrPtr + ActiveVarStoreHdrPtr->Size;
+  while ((UINT8 *)VarHdrPtr < ActiveEndPtr) {
+    if (VarHdrPtr->StartId != VARIABLE_DATA) {
+      break;
+    }
+
+    State = VarHdrPtr->State;
+    if (IS_HEADER_VALID (State) && IS_DATA_VALID (State) && !IS_DELETED (State)) {
+      Status = InternalGetVariable ((CHAR16 *)&VarHdrPtr[1], &VarHdrPtr->VariableGuid, NULL, &DataLen, NULL, &FindVarHdrPtr);
+      if (!EFI_ERROR (Status) && (FindVarHdrPtr == VarHdrPtr)) {
+        CopyMem (&VarHdr, VarHdrPtr, sizeof (VarHdr));
+        VarHdr.State |= VAR_IN_MIGRATION;
+        Status = ReclaimWrite (VarStoreHdrPtr, &CurPtr, (UINT8 *)&VarHdr, sizeof (VarHdr));
+        if (!EFI_ERROR (Status)) {
+          Status = ReclaimWrite (VarStoreHdrPtr, &CurPtr, (UINT8 *)&VarHdrPtr[1], VarHdrPtr->DataSize);
+        }
+        if (EFI_ERROR (Status)) {
+          return Status;
+        }
+      }
+    }
+
+    VarHdrPtr = (VARIABLE_HEADER *) ((UINT8 *)&VarHdrPtr[1] + VarHdrPtr->DataSize);
+  }
+
+  //
+  // Finish the partly filled block, then leave the rest of the free area
+  // erased one block at a time
+  //
+  Block = (UINT32)(CurPtr - (UINT8 *)VarStoreHdrPtr) / VARIABLE_BLOCK_SIZE;
+  for (; Block * VARIABLE_BLOCK_SIZE < VarStoreHdrPtr->Size; Block++) {
+    if ((Block * VARIABLE_BLOCK_SIZE) >= (UINT32)(CurPtr - (UINT8 *)VarStoreHdrPtr)) {
+      Status = StartReclaimBlock (VarStoreHdrPtr, Block);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+    }
+    Status = FinishReclaimBlock (VarStoreHdrPtr, Block, CurPtr);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
 
   This function reclaim the variable store from active region to the alternative region.
 
+  The alternative region is written one flash block at a time and the
+  progress is kept in its store header, see ReclaimCopy (). A reclaim that
+  was interrupted by a reset continues from the first block that is not
+  complete.
+
   @param   ActiveVarStoreHdrPtr       The active variable store header pointer
 
   @retval  EFI_DEVICE_ERROR      Failed to erase device
@@ -601,20 +1234,13 @@ Reclaim (
 {
   UINT32                  FullVarStoreLen;
   UINT32                  VarStoreLen;
-  VARIABLE_STORE_HEADER   VarStoreHdr;
   VARIABLE_STORE_HEADER  *VarStoreHdrPtr1;
   VARIABLE_STORE_HEADER  *VarStoreHdrPtr2;
   VARIABLE_STORE_HEADER  *InactiveVarStoreHdrPtr;
-  CHAR16                  VarName[VARIABLE_NAME_MAX_LEN];
   EFI_STATUS              Status;
-  VARIABLE_HEADER        *VarHdrPtr;
-  VARIABLE_HEADER         VarHdr;
-  UINT8                  *CurPtr;
-  UINTN                   DataLen;
-  UINTN                   NameSize;
+  VARIABLE_INSTANCE      *VarInstance;
   UINT8                   ActiveState;
   UINT8                   InactiveState;
-  EFI_GUID                VarGuid;
 
   DEBUG ((DEBUG_INFO, "Reclaiming variable storage\n"));
 
@@ -631,52 +1257,17 @@ Reclaim (
   } else {
     InactiveVarStoreHdrPtr = VarStoreHdrPtr1;
   }
-  CurPtr = (UINT8 *) (InactiveVarStoreHdrPtr + 1);
 
-  //
-  // Erase InactiveVarStoreHdrPtr
-  //
-  Status = EraseVariableStore (InactiveVarStoreHdrPtr, VarStoreLen);
-  if (EFI_ERROR (Status)) {
-    return EFI_DEVICE_ERROR;
-  }
-
-  //
-  // Copy variable over one by one
-  //
-  VarName[0] = 0;
-  while (TRUE) {
-    NameSize = sizeof (VarName);
-    Status   = GetNextVariableName (&NameSize, VarName, &VarGuid);
-    if (!EFI_ERROR (Status)) {
-      Status = InternalGetVariable (VarName, &VarGuid, NULL, &DataLen, NULL, &VarHdrPtr);
-      if (!EFI_ERROR (Status)) {
-        CopyMem (&VarHdr, VarHdrPtr, sizeof (VarHdr));
-        VarHdr.State |= VAR_IN_MIGRATION;
-        Status  = WriteVariableStore (CurPtr, sizeof (VarHdr), &VarHdr);
-        CurPtr += sizeof (VarHdr);
-        if (!EFI_ERROR (Status)) {
-          Status  = WriteVariableStore (CurPtr, VarHdrPtr->DataSize, (VOID *)&VarHdrPtr[1]);
-          CurPtr += VarHdrPtr->DataSize;
-        }
-        if (EFI_ERROR (Status)) {
-          return Status;
-        }
-      }
-    } else {
-      break;
-    }
+  Status = ReclaimCopy (ActiveVarStoreHdrPtr, InactiveVarStoreHdrPtr, IsReclaimInProgress (InactiveVarStoreHdrPtr, VarStoreLen));
+  if (Status == EFI_ABORTED) {
+    //
+    // The interrupted reclaim was started from different data, start over
+    //
+    DEBUG ((DEBUG_INFO, "Restarting variable reclaim\n"));
+    Status = ReclaimCopy (ActiveVarStoreHdrPtr, InactiveVarStoreHdrPtr, FALSE);
   }
-
-  //
-  // Write inactive store header
-  //
-  InactiveState = 0xFF;
-  CopyMem (&VarStoreHdr, ActiveVarStoreHdrPtr, sizeof (VarStoreHdr));
-  VarStoreHdr.State = InactiveState;
-  Status = WriteVariableStore (InactiveVarStoreHdrPtr, sizeof (VarStoreHdr), (VOID *)&VarStoreHdr);
   if (EFI_ERROR (Status)) {
-    return Status;
+    return EFI_DEVICE_ERROR;
   }
 
   //
@@ -691,7 +1282,7 @@ Reclaim (
   //
   // Mark inactive store as valid
   //
-  InactiveState = InactiveState & ~VAR_HEADER_VALID;
+  InactiveState = InactiveVarStoreHdrPtr->State & ~VAR_HEADER_VALID;
   Status = WriteVariableStore (&InactiveVarStoreHdrPtr->State, sizeof (InactiveVarStoreHdrPtr->State), &InactiveState);
   if (EFI_ERROR (Status)) {
     return Status;
@@ -706,6 +1297,14 @@ Reclaim (
     return Status;
   }
 
+  //
+  // All variables moved, rebuild the index against the new store
+  //
+  VarInstance = GetVariableInstance ();
+  if (VarInstance != NULL) {
+    BuildVariableIndex (VarInstance, InactiveVarStoreHdrPtr);
+  }
+
   return EFI_SUCCESS;
 }
 
@@ -758,6 +1357,7 @@ SetVariable (
   BOOLEAN                 CheckVarDataValid;
   BOOLEAN                 NeedReclaim;
   EFI_GUID                *VarGuid;
+  VARIABLE_INSTANCE      *VarInstance;
 
   if ((VariableName == NULL) || (VariableName[0] == 0)) {
     return EFI_INVALID_PARAMETER;
@@ -772,6 +1372,11 @@ SetVariable (
     VarGuid = &gZeroGuid;
   }
 
+  VarInstance = GetVariableInstance ();
+  if (VarInstance == NULL) {
+    return EFI_NOT_READY;
+  }
+
   VarStoreHdrPtr = GetActiveVaraibelStoreBase (&VarStoreLen);
   if (!IsVariableStoreValid (VarStoreHdrPtr)) {
     return EFI_VOLUME_CORRUPTED;
@@ -910,6 +1515,7 @@ SetVariable (
   }
 
   if (SkipVarWrite) {
+    UpdateVariableIndex (VarInstance, VariableName, VarGuid, FindVarHdrPtr);
     return EFI_SUCCESS;
   }
 
@@ -986,6 +1592,7 @@ SetVariable (
       return Status;
     }
 
+    UpdateVariableIndex (VarInstance, VariableName, VarGuid, VarHdrPtr);
   }
 
   if (FindVarHdrPtr != NULL) {
@@ -997,6 +1604,9 @@ SetVariable (
     if (EFI_ERROR (Status)) {
       return Status;
     }
+    if (DataSize == 0) {
+      UpdateVariableIndex (VarInstance, VariableName, VarGuid, NULL);
+    }
   } else {
     if (DataSize == 0) {
       return EFI_NOT_FOUND;
@@ -1085,8 +1695,10 @@ VariableConstructor (
   IN  UINT32    Size
   )
 {
-  EFI_STATUS         Status;
-  VARIABLE_INSTANCE *VarInstance;
+  EFI_STATUS              Status;
+  VARIABLE_INSTANCE      *VarInstance;
+  VARIABLE_STORE_HEADER  *VarStoreHdrPtr;
+  VARIABLE_STORE_HEADER  *InactiveVarStoreHdrPtr;
 
   VarInstance = GetVariableInstance();
   ASSERT (VarInstance != NULL);
@@ -1111,6 +1723,26 @@ VariableConstructor (
     return Status;
   }
 
+  //
+  // Continue a reclaim that was interrupted by a reset
+  //
+  VarStoreHdrPtr = GetActiveVaraibelStoreBase (NULL);
+  if ((UINTN)VarStoreHdrPtr == Base) {
+    InactiveVarStoreHdrPtr = (VARIABLE_STORE_HEADER *)(UINTN)(Base + (Size >> 1));
+  } else {
+    InactiveVarStoreHdrPtr = (VARIABLE_STORE_HEADER *)(UINTN)Base;
+  }
+  if (IsReclaimInProgress (InactiveVarStoreHdrPtr, Size >> 1)) {
+    Status = Reclaim (VarStoreHdrPtr);
+    DEBUG ((DEBUG_INFO, "Resume variable reclaim: %r\n", Status));
+  }
+
+  //
+  // Build the name to offset index once, later lookups do not scan the store
+  //
+  BuildVariableIndex (VarInstance, GetActiveVaraibelStoreBase (NULL));
+  DEBUG ((DEBUG_INFO, "Variable index: %d entries, state %d\n", VarInstance->IndexCount, VarInstance->IndexState));
+
   Status = RegisterService ((VOID *)&mVariableService);
   return Status;
 }
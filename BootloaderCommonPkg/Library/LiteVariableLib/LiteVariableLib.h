@@ -1,7 +1,7 @@
 /** @file
 Lite variable service library header file
 
-Copyright (c) 2006 - 2016, Intel Corporation. All rights reserved.<BR>
+Copyright (c) 2006 - 2026, Intel Corporation. All rights reserved.<BR>
 Portions copyright (c) 2008 - 2009, Apple Inc. All rights reserved.<BR>
 SPDX-License-Identifier: BSD-2-Clause-Patent
 
@@ -26,10 +26,53 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 ///
 #define VARIABLE_INSTANCE_SIGNATURE  SIGNATURE_32 ('V', 'A', 'R', 'I')
 
+///
+/// Maximum number of variables tracked by the in-RAM index.
+/// Variables beyond this count are still found by scanning the store.
+///
+#define VARIABLE_INDEX_MAX_ENTRIES   32
+
+///
+/// Number of slots in the in-RAM index hash table, must be a power of 2.
+/// It is kept twice as large as VARIABLE_INDEX_MAX_ENTRIES so probing
+/// always ends at an empty slot.
+///
+#define VARIABLE_INDEX_SLOTS         64
+
+///
+/// Variable index states.
+///
+#define VARIABLE_INDEX_NONE          0
+#define VARIABLE_INDEX_COMPLETE      1
+#define VARIABLE_INDEX_PARTIAL       2
+
+///
+/// Variable store flash erase block size.
+///
+#define VARIABLE_BLOCK_SIZE          SIZE_4KB
+
+///
+/// Number of store blocks whose reclaim progress is recorded in the store
+/// header. Blocks past this count are redone when a reclaim is resumed.
+///
+#define VARIABLE_RECLAIM_MAP_BLOCKS  (sizeof (((VARIABLE_STORE_HEADER *)0)->ReclaimMap) * 8)
+
+typedef struct {
+  UINT32                Hash;
+  ///
+  /// Offset of the VARIABLE_HEADER from StoreBase, 0 for an empty slot.
+  ///
+  UINT32                Offset;
+} VARIABLE_INDEX_ENTRY;
+
 typedef struct {
   UINT32                Signature;
   UINT32                StoreSize;
   UINT32                StoreBase;
+  UINT8                 IndexState;
+  UINT8                 Reserved[3];
+  UINT32                IndexCount;
+  VARIABLE_INDEX_ENTRY  Index[VARIABLE_INDEX_SLOTS];
 } VARIABLE_INSTANCE;
 
 #endif
@@ -1,7 +1,7 @@
 /** @file
   The variable data structures.
 
-  Copyright (c) 2017 - 2023, Intel Corporation. All rights reserved.<BR>
+  Copyright (c) 2017 - 2026, Intel Corporation. All rights reserved.<BR>
 SPDX-License-Identifier: BSD-2-Clause-Patent
 
 **/
@@ -62,7 +62,11 @@ typedef struct {
   /// Variable region healthy state.
   ///
   UINT8   State;
-  UINT8   Reserved[6];
+  ///
+  /// Reclaim progress, one bit per flash block of the store.
+  /// A bit is cleared once Reclaim has completed the block.
+  ///
+  UINT8   ReclaimMap[6];
 } VARIABLE_STORE_HEADER;
 
 ///
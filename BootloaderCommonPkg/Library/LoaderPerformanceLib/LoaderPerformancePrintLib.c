@@ -101,6 +101,8 @@ DefPerfIdToStr (
     return "Display splash";
   case 0x3060:
     return "MP wake up";
+  case 0x3070:
+    return "MP AP check-in";
   case 0x3080:
     return "MP init run";
   case 0x3090:
@@ -127,6 +129,8 @@ DefPerfIdToStr (
     return "Decompress payload";
   case 0x3150:
     return "Extend payload hash";
+  case 0x3190:
+    return "Board EndOfStages hook";
   case 0x31A0:
     return "Board PostPayloadLoading hook";
   case 0x31B0:
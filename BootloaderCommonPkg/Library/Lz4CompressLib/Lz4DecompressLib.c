@@ -142,3 +142,45 @@ Lz4Decompress (
     return RETURN_INVALID_PARAMETER;
   }
 }
+
+/**
+  Decompresses a single raw LZ4 block.
+
+  Unlike Lz4Decompress(), the source has no size header. This is the block
+  format used inside LZ4 frames.
+
+  @param[in]  Source           The source buffer containing the compressed block.
+  @param[in]  SourceSize       The size of the compressed block.
+  @param[out] Destination      The destination buffer to store the decompressed data.
+  @param[in]  DestinationSize  The size of the destination buffer.
+  @param[out] DecodedSize      The number of bytes written into Destination.
+
+  @retval  RETURN_SUCCESS            The block was decompressed successfully.
+  @retval  RETURN_INVALID_PARAMETER  The block is corrupted or does not fit
+                                     into the destination buffer.
+**/
+RETURN_STATUS
+EFIAPI
+Lz4DecompressBlock (
+  IN  CONST VOID  *Source,
+  IN  UINT32       SourceSize,
+  OUT VOID        *Destination,
+  IN  UINT32       DestinationSize,
+  OUT UINT32      *DecodedSize
+  )
+{
+  INT32        Size;
+
+  if ((Source == NULL) || (Destination == NULL) || (DecodedSize == NULL) ||
+      (SourceSize > MAX_INT32) || (DestinationSize > MAX_INT32)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  Size = LZ4_decompress_safe (Source, Destination, (INT32)SourceSize, (INT32)DestinationSize);
+  if (Size < 0) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  *DecodedSize = (UINT32)Size;
+  return RETURN_SUCCESS;
+}
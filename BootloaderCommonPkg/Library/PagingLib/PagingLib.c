@@ -1,6 +1,6 @@
 /** @file
 
-  Copyright (c) 2020, Intel Corporation. All rights reserved.<BR>
+  Copyright (c) 2020 - 2026, Intel Corporation. All rights reserved.<BR>
   SPDX-License-Identifier: BSD-2-Clause-Patent
 
 **/
@@ -380,6 +380,7 @@ CreateIdentityMappingPageTables (
   BOOLEAN           Page5LevelSupport;
   UINT8             PhysicalAddressBits;
   UINTN             TotalPagesNum;
+  UINTN             LeafPagesNum;
   UINT32            NumOfPml5Entries;
   UINT32            NumOfPml4Entries;
   UINT32            NumOfPdpEntries;
@@ -444,7 +445,19 @@ CreateIdentityMappingPageTables (
   if (PageBuffer == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
-  ZeroMem (PageBuffer, EFI_PAGES_TO_SIZE (TotalPagesNum));
+
+  //
+  // The leaf level is placed last and all its entries are written below,
+  // so only the upper levels need to be cleared.
+  //
+  if (Page5LevelSupport) {
+    LeafPagesNum = 0;
+  } else if (Page1GSupport) {
+    LeafPagesNum = (UINTN)NumOfPml4Entries;
+  } else {
+    LeafPagesNum = (UINTN)NumOfPdpEntries * NumOfPml4Entries;
+  }
+  ZeroMem (PageBuffer, EFI_PAGES_TO_SIZE (TotalPagesNum - LeafPagesNum));
 
   Address   = 0;
   Attribute = IA32_PG_P | IA32_PG_RW;
@@ -487,6 +500,9 @@ CreateIdentityMappingPageTables (
     }
   }
 
+  DEBUG ((DEBUG_INFO, "Identity mapped 0x0 - 0x%016lx with %a pages, page tables use %Lu KB\n",
+    (UINT64)Address - 1, Page1GSupport ? "1GB" : "2MB", RShiftU64 (EFI_PAGES_TO_SIZE ((UINT64)TotalPagesNum), 10)));
+
   Cr0 = AsmReadCr0 ();
   // Set PAE
   AsmWriteCr4 (AsmReadCr4() | BIT5);
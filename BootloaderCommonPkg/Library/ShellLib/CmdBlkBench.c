@@ -0,0 +1,387 @@
+/** @file
+  Shell command `blkbench` to measure block device read performance.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Library/BootloaderCommonLib.h>
+#include <Library/ShellLib.h>
+#include <Library/MediaAccessLib.h>
+#include <Library/ConsoleInLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/TimeStampLib.h>
+#include <Library/BootOptionLib.h>
+#include <Guid/OsBootOptionGuid.h>
+
+#define  BENCH_MAX_XFER_SIZE        SIZE_1MB
+#define  BENCH_DEFAULT_SEQ_SIZE     SIZE_16MB
+#define  BENCH_DEFAULT_RAND_COUNT   256
+#define  BENCH_RAND_XFER_SIZE       SIZE_4KB
+#define  BENCH_LATENCY_BUCKETS      16
+
+//
+// Request sizes used for the sequential read pass
+//
+STATIC CONST UINT32  mSeqXferSize[] = { SIZE_4KB, SIZE_64KB, SIZE_1MB };
+
+/**
+  Measure block device read performance.
+
+  @param[in]  Shell        shell instance
+  @param[in]  Argc         number of command line arguments
+  @param[in]  Argv         command line arguments
+
+  @retval EFI_SUCCESS
+
+**/
+EFI_STATUS
+EFIAPI
+ShellCommandBlkBenchFunc (
+  IN SHELL  *Shell,
+  IN UINTN   Argc,
+  IN CHAR16 *Argv[]
+  );
+
+CONST SHELL_COMMAND ShellCommandBlkBench = {
+  L"blkbench",
+  L"Measure block device read throughput and latency",
+  &ShellCommandBlkBenchFunc
+};
+
+/**
+  Get a pseudo random number.
+
+  A fixed seed is used so that the same LBA sequence is accessed in every
+  run and results can be compared between builds.
+
+  @param[in, out]  Seed    Random state, updated on return.
+
+  @retval          Next pseudo random number.
+
+**/
+STATIC
+UINT64
+BenchRandom (
+  IN OUT UINT64   *Seed
+  )
+{
+  UINT64   Value;
+
+  Value  = *Seed;
+  Value ^= LShiftU64 (Value, 13);
+  Value ^= RShiftU64 (Value, 7);
+  Value ^= LShiftU64 (Value, 17);
+  *Seed  = Value;
+
+  return Value;
+}
+
+/**
+  Print throughput for a number of bytes transferred in a period of time.
+
+  @param[in]  Bytes       Number of bytes transferred.
+  @param[in]  TimeUs      Elapsed time in microseconds.
+
+**/
+STATIC
+VOID
+PrintThroughput (
+  IN  UINT64   Bytes,
+  IN  UINT64   TimeUs
+  )
+{
+  UINT64   KbPerSec;
+
+  if (TimeUs == 0) {
+    TimeUs = 1;
+  }
+  KbPerSec = RShiftU64 (DivU64x64Remainder (MultU64x32 (Bytes, 1000000), TimeUs, NULL), 10);
+  ShellPrint (L"%8ld KB/s | %8ld us\n", KbPerSec, TimeUs);
+}
+
+/**
+  Run sequential read pass with different request sizes.
+
+  @param[in]  HwPart      Hardware partition number.
+  @param[in]  BlockInfo   Device block information.
+  @param[in]  TotalSize   Number of bytes to read in each pass.
+  @param[in]  Buffer      Buffer of at least BENCH_MAX_XFER_SIZE bytes.
+
+  @retval EFI_SUCCESS     All passes completed.
+  @retval Others          A read failed.
+
+**/
+STATIC
+EFI_STATUS
+BenchSequentialRead (
+  IN  UINT32              HwPart,
+  IN  DEVICE_BLOCK_INFO  *BlockInfo,
+  IN  UINT64              TotalSize,
+  IN  VOID               *Buffer
+  )
+{
+  EFI_STATUS   Status;
+  UINTN        Index;
+  UINT32       XferSize;
+  UINT32       XferBlocks;
+  UINT64       Offset;
+  EFI_LBA      Lba;
+  UINT64       Start;
+  UINT64       TimeUs;
+
+  ShellPrint (L"\nSequential read (%ld KB per pass)\n", RShiftU64 (TotalSize, 10));
+  ShellPrint (L"  Request |   Throughput  |    Time\n");
+  for (Index = 0; Index < ARRAY_SIZE (mSeqXferSize); Index++) {
+    XferSize = mSeqXferSize[Index];
+    if (XferSize < BlockInfo->BlockSize) {
+      continue;
+    }
+    XferBlocks = XferSize / BlockInfo->BlockSize;
+
+    Lba    = 0;
+    Offset = 0;
+    Start  = ReadTimeStamp ();
+    while (Offset < TotalSize) {
+      Status = MediaReadBlocks (HwPart, Lba, XferSize, Buffer);
+      if (EFI_ERROR (Status)) {
+        ShellPrint (L"Read LBA 0x%lx failed - %r\n", Lba, Status);
+        return Status;
+      }
+      Lba    += XferBlocks;
+      Offset += XferSize;
+    }
+    TimeUs = TimeStampTickToMicroSecond (ReadTimeStamp () - Start);
+
+    ShellPrint (L"  %5d KB | ", XferSize >> 10);
+    PrintThroughput (TotalSize, TimeUs);
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Run random read pass and print the per-command latency histogram.
+
+  @param[in]  HwPart      Hardware partition number.
+  @param[in]  BlockInfo   Device block information.
+  @param[in]  Count       Number of read commands to issue.
+  @param[in]  Buffer      Buffer of at least BENCH_RAND_XFER_SIZE bytes.
+
+  @retval EFI_SUCCESS     All reads completed.
+  @retval Others          A read failed.
+
+**/
+STATIC
+EFI_STATUS
+BenchRandomRead (
+  IN  UINT32              HwPart,
+  IN  DEVICE_BLOCK_INFO  *BlockInfo,
+  IN  UINT32              Count,
+  IN  VOID               *Buffer
+  )
+{
+  EFI_STATUS   Status;
+  UINT32       Histogram[BENCH_LATENCY_BUCKETS];
+  UINT32       XferSize;
+  UINT32       XferBlocks;
+  UINT64       Slots;
+  UINT64       Seed;
+  UINT64       Slot;
+  EFI_LBA      Lba;
+  UINT64       Start;
+  UINT64       TimeUs;
+  UINT64       TotalUs;
+  UINT64       MinUs;
+  UINT64       MaxUs;
+  UINT32       Index;
+  UINT32       Bucket;
+
+  XferSize   = MAX (BENCH_RAND_XFER_SIZE, BlockInfo->BlockSize);
+  XferBlocks = XferSize / BlockInfo->BlockSize;
+  Slots      = DivU64x32 (BlockInfo->BlockNum, XferBlocks);
+  if (Slots == 0) {
+    return EFI_SUCCESS;
+  }
+
+  ZeroMem (Histogram, sizeof (Histogram));
+  Seed    = 0x2545F4914F6CDD1DULL;
+  TotalUs = 0;
+  MinUs   = MAX_UINT64;
+  MaxUs   = 0;
+  for (Index = 0; Index < Count; Index++) {
+    DivU64x64Remainder (BenchRandom (&Seed), Slots, &Slot);
+    Lba = MultU64x32 (Slot, XferBlocks);
+
+    Start  = ReadTimeStamp ();
+    Status = MediaReadBlocks (HwPart, Lba, XferSize, Buffer);
+    TimeUs = TimeStampTickToMicroSecond (ReadTimeStamp () - Start);
+    if (EFI_ERROR (Status)) {
+      ShellPrint (L"Read LBA 0x%lx failed - %r\n", Lba, Status);
+      return Status;
+    }
+
+    TotalUs += TimeUs;
+    MinUs    = MIN (MinUs, TimeUs);
+    MaxUs    = MAX (MaxUs, TimeUs);
+    Bucket   = (TimeUs == 0) ? 0 : (UINT32)HighBitSet64 (TimeUs) + 1;
+    Histogram[MIN (Bucket, BENCH_LATENCY_BUCKETS - 1)]++;
+  }
+
+  ShellPrint (L"\nRandom read (%d x %d KB)\n", Count, XferSize >> 10);
+  ShellPrint (L"  %d KB    | ", XferSize >> 10);
+  PrintThroughput (MultU64x32 (Count, XferSize), TotalUs);
+  ShellPrint (L"  Latency min %ld us, avg %ld us, max %ld us\n",
+    MinUs, DivU64x32 (TotalUs, Count), MaxUs);
+  ShellPrint (L"      Latency (us)     | Count\n");
+  for (Bucket = 0; Bucket < BENCH_LATENCY_BUCKETS; Bucket++) {
+    if (Histogram[Bucket] == 0) {
+      continue;
+    }
+    if (Bucket == 0) {
+      ShellPrint (L"  [       0,        1) | %d\n", Histogram[Bucket]);
+    } else if (Bucket == BENCH_LATENCY_BUCKETS - 1) {
+      ShellPrint (L"  [%8d,        -) | %d\n", 1 << (Bucket - 1), Histogram[Bucket]);
+    } else {
+      ShellPrint (L"  [%8d, %8d) | %d\n", 1 << (Bucket - 1), 1 << Bucket, Histogram[Bucket]);
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Measure block device read performance.
+
+  Only reads are issued so the command is safe to run on a device holding
+  the OS. The block device libraries are synchronous, so every command is
+  issued at queue depth 1; the sequential pass reports scaling by request
+  size instead.
+
+  @param[in]  Shell        shell instance
+  @param[in]  Argc         number of command line arguments
+  @param[in]  Argv         command line arguments
+
+  @retval EFI_SUCCESS
+
+**/
+EFI_STATUS
+EFIAPI
+ShellCommandBlkBenchFunc (
+  IN SHELL  *Shell,
+  IN UINTN   Argc,
+  IN CHAR16 *Argv[]
+  )
+{
+  EFI_STATUS          Status;
+  OS_BOOT_MEDIUM_TYPE DeviceType;
+  UINT8               DeviceInstance;
+  UINT32              HwPart;
+  UINT64              SeqSize;
+  UINT32              RandCount;
+  CHAR16             *String;
+  UINTN               Result;
+  UINTN               BaseAddress;
+  DEVICE_BLOCK_INFO   BlockInfo;
+  VOID               *Buffer;
+
+  if (Argc < 2) {
+    goto Usage;
+  }
+
+  Status = StrHexToUintnS (Argv[1], &String, &Result);
+  if (EFI_ERROR (Status) || (Result >= OsBootDeviceMax)) {
+    goto Usage;
+  }
+  DeviceType = (OS_BOOT_MEDIUM_TYPE)Result;
+
+  Result = 0;
+  if (String[0] == L':') {
+    String++;
+    Status = StrHexToUintnS (String, NULL, &Result);
+    if (EFI_ERROR (Status)) {
+      goto Usage;
+    }
+  }
+  DeviceInstance = (UINT8)Result;
+
+  HwPart    = (Argc < 3) ? 0 : (UINT32)StrHexToUintn (Argv[2]);
+  SeqSize   = (Argc < 4) ? BENCH_DEFAULT_SEQ_SIZE : LShiftU64 (StrDecimalToUintn (Argv[3]), 20);
+  RandCount = (Argc < 5) ? BENCH_DEFAULT_RAND_COUNT : (UINT32)StrDecimalToUintn (Argv[4]);
+
+  BaseAddress = GetDeviceAddr (DeviceType, DeviceInstance);
+  if (BaseAddress == 0) {
+    ShellPrint (L"Device %d:%d (%a) is not in platform devices.\n",
+      DeviceType, DeviceInstance, GetBootDeviceNameString (DeviceType));
+    return EFI_ABORTED;
+  } else if (!(BaseAddress & 0xFF000000)) {
+    BaseAddress = TO_MM_PCI_ADDRESS (BaseAddress);
+  }
+
+  Status = MediaSetInterfaceType (DeviceType);
+  if (EFI_ERROR (Status)) {
+    ShellPrint (L"Media(%a) is not supported - %r\n", GetBootDeviceNameString (DeviceType), Status);
+    return Status;
+  }
+
+  Buffer = NULL;
+  Status = MediaInitialize (BaseAddress, DevInitAll);
+  if (EFI_ERROR (Status)) {
+    ShellPrint (L"Media(%a) Init Fail - %r\n", GetBootDeviceNameString (DeviceType), Status);
+    goto Exit;
+  }
+
+  Status = MediaGetMediaInfo (HwPart, &BlockInfo);
+  if (EFI_ERROR (Status) || (BlockInfo.BlockSize == 0) || (BlockInfo.BlockNum == 0)) {
+    ShellPrint (L"Get media info for hwpart %d failed - %r\n", HwPart, Status);
+    goto Exit;
+  }
+
+  ShellPrint (L"Media(%a) %d:%d hwpart %d: BlockNum 0x%lx, BlockSize 0x%x\n",
+    GetBootDeviceNameString (DeviceType), DeviceType, DeviceInstance, HwPart,
+    BlockInfo.BlockNum, BlockInfo.BlockSize);
+
+  Buffer = AllocatePages (EFI_SIZE_TO_PAGES (BENCH_MAX_XFER_SIZE));
+  if (Buffer == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Exit;
+  }
+
+  SeqSize = MIN (SeqSize, MultU64x32 (BlockInfo.BlockNum, BlockInfo.BlockSize));
+  SeqSize = SeqSize & ~((UINT64)BENCH_MAX_XFER_SIZE - 1);
+  if (SeqSize != 0) {
+    Status = BenchSequentialRead (HwPart, &BlockInfo, SeqSize, Buffer);
+    if (EFI_ERROR (Status)) {
+      goto Exit;
+    }
+  }
+
+  if (RandCount != 0) {
+    Status = BenchRandomRead (HwPart, &BlockInfo, RandCount, Buffer);
+  }
+
+Exit:
+  if (Buffer != NULL) {
+    FreePages (Buffer, EFI_SIZE_TO_PAGES (BENCH_MAX_XFER_SIZE));
+  }
+
+  // If USB keyboard console is used, don't DeInit USB.
+  if (!((DeviceType == OsBootDeviceUsb) &&
+      ((PcdGet32 (PcdConsoleInDeviceMask) & ConsoleInUsbKeyboard) != 0))) {
+    MediaInitialize (0, DevDeinit);
+  }
+
+  return Status;
+
+Usage:
+  ShellPrint (L"Usage: %s DevType[:DevInstance] [HwPart] [SeqMB] [RandCount]\n", Argv[0]);
+  ShellPrint (L"\nDevType:DevInstance - Media type and instance number in the same media type\n");
+  ShellPrint (L"HwPart    - HW partition or port number (default 0)\n");
+  ShellPrint (L"SeqMB     - MB to read in each sequential pass (default %d)\n", BENCH_DEFAULT_SEQ_SIZE >> 20);
+  ShellPrint (L"RandCount - Number of random %d KB reads (default %d)\n",
+    BENCH_RAND_XFER_SIZE >> 10, BENCH_DEFAULT_RAND_COUNT);
+
+  return EFI_ABORTED;
+}
@@ -0,0 +1,193 @@
+/** @file
+  Shell command `membench` to measure BaseMemoryLib throughput.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Library/BootloaderCommonLib.h>
+#include <Library/ShellLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/TimeStampLib.h>
+#include <Library/MpServiceLib.h>
+
+#define  BENCH_DEFAULT_MAX_SIZE     SIZE_16MB
+#define  BENCH_BYTES_PER_PASS       SIZE_64MB
+
+typedef enum {
+  BenchCopyMem,
+  BenchSetMem,
+  BenchZeroMem,
+  BenchCompareMem,
+  BenchCpuSetMem,
+  BenchMax
+} MEM_BENCH_OP;
+
+//
+// Buffer sizes, from cache resident to well beyond the last level cache
+//
+STATIC CONST UINT32  mBenchSize[] = { SIZE_4KB, SIZE_64KB, SIZE_1MB, SIZE_4MB, SIZE_16MB, SIZE_64MB };
+
+/**
+  Measure BaseMemoryLib throughput.
+
+  @param[in]  Shell        shell instance
+  @param[in]  Argc         number of command line arguments
+  @param[in]  Argv         command line arguments
+
+  @retval EFI_SUCCESS
+
+**/
+EFI_STATUS
+EFIAPI
+ShellCommandMemBenchFunc (
+  IN SHELL  *Shell,
+  IN UINTN   Argc,
+  IN CHAR16 *Argv[]
+  );
+
+CONST SHELL_COMMAND ShellCommandMemBench = {
+  L"membench",
+  L"Measure CopyMem/SetMem/ZeroMem/CompareMem/CpuSetMem throughput",
+  &ShellCommandMemBenchFunc
+};
+
+/**
+  Run one memory operation repeatedly and return its throughput.
+
+  @param[in]  Op          Memory operation to run.
+  @param[in]  Dst         Destination buffer.
+  @param[in]  Src         Source buffer, same content as Dst for CompareMem.
+  @param[in]  Size        Size of each operation in bytes.
+
+  @retval     Throughput in MB/s.
+
+**/
+STATIC
+UINT64
+BenchMemOp (
+  IN  MEM_BENCH_OP   Op,
+  IN  UINT8         *Dst,
+  IN  UINT8         *Src,
+  IN  UINT32         Size
+  )
+{
+  UINT32       Count;
+  UINT32       Index;
+  UINT64       Start;
+  UINT64       TimeUs;
+  INTN         Result;
+
+  Count  = MAX (BENCH_BYTES_PER_PASS / Size, 1);
+  Result = 0;
+  Start  = ReadTimeStamp ();
+  for (Index = 0; Index < Count; Index++) {
+    switch (Op) {
+    case BenchCopyMem:
+      CopyMem (Dst, Src, Size);
+      break;
+    case BenchSetMem:
+      SetMem (Dst, Size, (UINT8)Index);
+      break;
+    case BenchZeroMem:
+      ZeroMem (Dst, Size);
+      break;
+    case BenchCompareMem:
+      Result |= CompareMem (Dst, Src, Size);
+      break;
+    default:
+      CpuSetMem (Dst, Size, 0);
+      break;
+    }
+  }
+  TimeUs = TimeStampTickToMicroSecond (ReadTimeStamp () - Start);
+
+  if (Result != 0) {
+    ShellPrint (L"CompareMem mismatch!\n");
+  }
+
+  if (TimeUs == 0) {
+    TimeUs = 1;
+  }
+  return RShiftU64 (DivU64x64Remainder (MultU64x32 (MultU64x32 (Count, Size), 1000000), TimeUs, NULL), 20);
+}
+
+/**
+  Measure BaseMemoryLib throughput.
+
+  @param[in]  Shell        shell instance
+  @param[in]  Argc         number of command line arguments
+  @param[in]  Argv         command line arguments
+
+  @retval EFI_SUCCESS
+
+**/
+EFI_STATUS
+EFIAPI
+ShellCommandMemBenchFunc (
+  IN SHELL  *Shell,
+  IN UINTN   Argc,
+  IN CHAR16 *Argv[]
+  )
+{
+  UINT32              MaxSize;
+  UINT8              *Src;
+  UINT8              *Dst;
+  UINTN               Index;
+  UINT32              Size;
+  UINTN               Op;
+  SYS_CPU_TASK       *SysCpuTask;
+
+  MaxSize = (Argc < 2) ? BENCH_DEFAULT_MAX_SIZE : (UINT32)StrDecimalToUintn (Argv[1]) << 20;
+  if ((MaxSize < SIZE_1MB) || (MaxSize > SIZE_64MB)) {
+    ShellPrint (L"Usage: %s [MaxMB]\n", Argv[0]);
+    ShellPrint (L"\nMaxMB - Largest buffer size in MB, 1 to 64 (default %d)\n", BENCH_DEFAULT_MAX_SIZE >> 20);
+    ShellPrint (L"Run it on builds using different BaseMemoryLib instances to compare them.\n");
+    return EFI_ABORTED;
+  }
+
+  Src = AllocatePages (EFI_SIZE_TO_PAGES (MaxSize));
+  Dst = AllocatePages (EFI_SIZE_TO_PAGES (MaxSize));
+  if ((Src == NULL) || (Dst == NULL)) {
+    ShellPrint (L"Failed to allocate 2 x %d MB buffers\n", MaxSize >> 20);
+    if (Src != NULL) {
+      FreePages (Src, EFI_SIZE_TO_PAGES (MaxSize));
+    }
+    if (Dst != NULL) {
+      FreePages (Dst, EFI_SIZE_TO_PAGES (MaxSize));
+    }
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  SysCpuTask = GetCpuTask ();
+  ShellPrint (L"Throughput in MB/s, %d MB moved per test, CpuSetMem on %d CPUs\n", BENCH_BYTES_PER_PASS >> 20,
+    (SysCpuTask == NULL) ? 1 : SysCpuTask->CpuCount);
+  ShellPrint (L"     Size |  CopyMem |   SetMem |  ZeroMem | CompareMem | CpuSetMem\n");
+  for (Index = 0; Index < ARRAY_SIZE (mBenchSize); Index++) {
+    Size = mBenchSize[Index];
+    if (Size > MaxSize) {
+      break;
+    }
+
+    if (Size >= SIZE_1MB) {
+      ShellPrint (L"  %4d MB |", Size >> 20);
+    } else {
+      ShellPrint (L"  %4d KB |", Size >> 10);
+    }
+    for (Op = BenchCopyMem; Op < BenchMax; Op++) {
+      if (Op == BenchCompareMem) {
+        // Compare equal buffers so that the whole buffer is scanned
+        CopyMem (Dst, Src, Size);
+      }
+      ShellPrint ((Op == BenchCpuSetMem) ? L" %9ld\n" : ((Op == BenchCompareMem) ? L" %10ld |" : L" %8ld |"),
+        BenchMemOp ((MEM_BENCH_OP)Op, Dst, Src, Size));
+    }
+  }
+
+  FreePages (Src, EFI_SIZE_TO_PAGES (MaxSize));
+  FreePages (Dst, EFI_SIZE_TO_PAGES (MaxSize));
+
+  return EFI_SUCCESS;
+}
@@ -48,6 +48,8 @@ LoadShellCommands (
     ShellCommandRegister (Shell, &ShellCommandDmesg);
     ShellCommandRegister (Shell, &ShellCommandReset);
     ShellCommandRegister (Shell, &ShellCommandFs);
+    ShellCommandRegister (Shell, &ShellCommandBlkBench);
+    ShellCommandRegister (Shell, &ShellCommandMemBench);
     ShellCommandRegister (Shell, &ShellCommandUsbDev);
     ShellCommandRegister (Shell, &ShellCommandAcpi);
     ShellCommandRegister (Shell, &ShellCommandFlashmap);
@@ -28,6 +28,8 @@ extern CONST SHELL_COMMAND ShellCommandReset;
 extern CONST SHELL_COMMAND ShellCommandUcode;
 extern CONST SHELL_COMMAND ShellCommandCls;
 extern CONST SHELL_COMMAND ShellCommandFs;
+extern CONST SHELL_COMMAND ShellCommandBlkBench;
+extern CONST SHELL_COMMAND ShellCommandMemBench;
 extern CONST SHELL_COMMAND ShellCommandUsbDev;
 extern CONST SHELL_COMMAND ShellCommandCorruptComp;
 extern CONST SHELL_COMMAND ShellCommandAcpi;
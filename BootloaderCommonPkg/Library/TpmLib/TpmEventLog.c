@@ -123,6 +123,54 @@ GetUnCompressedTCGEventSize (
 }
 
 
+/**
+  Get the offset of the first free slot in the TCG 2.0 event log.
+
+  The offset is cached in TPM Lib private data and advanced on every append.
+  If it is not known yet (e.g. log area was populated by an earlier stage
+  without the index), the log is walked once.
+
+  @param[in]  TpmLibData  TPM Lib private data.
+
+  @retval Offset of the free slot relative to the log area start.
+**/
+STATIC
+UINT32
+GetTCGLogFreeOffset (
+  IN  TPM_LIB_PRIVATE_DATA  *TpmLibData
+  )
+{
+  UINT8                 *Lasa;
+  UINT32                Laml;
+  TCG_PCR_EVENT_HDR     *FirstEvent;
+  TCG_PCR_EVENT2_HDR    *EmptySlot;
+  UINT32                EventSize;
+
+  if (TpmLibData->LogAreaFreeOffset != 0) {
+    return TpmLibData->LogAreaFreeOffset;
+  }
+
+  Lasa = (UINT8 *)(UINTN)TpmLibData->LogAreaStartAddress;
+  Laml = TpmLibData->LogAreaMinLength;
+
+  // Note : First Event is of type TPM 1.2 (TCG_PCR_EVENT_HDR)
+  FirstEvent = (TCG_PCR_EVENT_HDR *)Lasa;
+  EmptySlot  = (TCG_PCR_EVENT2_HDR *)
+               ((UINT8 *)FirstEvent + sizeof (TCG_PCR_EVENT_HDR) + FirstEvent->EventSize);
+
+  while (EmptySlot < (TCG_PCR_EVENT2_HDR *)(Lasa + Laml - 1)) {
+    EventSize = GetCompressedTCGEventSize (EmptySlot);
+    if (EventSize == 0) {
+      break;
+    }
+    EmptySlot = (TCG_PCR_EVENT2_HDR *) ((UINT8 *)EmptySlot + EventSize);
+  }
+
+  TpmLibData->LogAreaFreeOffset = (UINT32)((UINT8 *)EmptySlot - Lasa);
+  return TpmLibData->LogAreaFreeOffset;
+}
+
+
 /**
   Allocate and initialize TCG Event Log.
 
@@ -180,6 +228,8 @@ CreateTpmEventLogHob (
   TCG_PCR_EVENT2_HDR    *EmptySlot;
   TCG_PCR_EVENT_HDR     *FirstEvent;
   UINT32                EventSize;
+  UINT32                LogEnd;
+  TPM_LIB_PRIVATE_DATA  *TpmLibData;
 
   GetTCGLasa (&Lasa, &Laml);
   if (Lasa == 0 || Laml == 0 ) {
@@ -187,11 +237,19 @@ CreateTpmEventLogHob (
     return RETURN_BUFFER_TOO_SMALL;
   }
 
+  // Only walk the populated part of the log area
+  TpmLibData = TpmLibGetPrivateData ();
+  if (TpmLibData != NULL) {
+    LogEnd = Lasa + GetTCGLogFreeOffset (TpmLibData);
+  } else {
+    LogEnd = Lasa + Laml - 1;
+  }
+
   FirstEvent = (TCG_PCR_EVENT_HDR *)(UINTN)Lasa;
   EmptySlot  = (TCG_PCR_EVENT2_HDR *)
                ((UINT8 *)FirstEvent + sizeof (TCG_PCR_EVENT_HDR) + FirstEvent->EventSize);
 
-  while (EmptySlot < (TCG_PCR_EVENT2_HDR *)(UINTN)(Lasa + Laml - 1)) {
+  while (EmptySlot < (TCG_PCR_EVENT2_HDR *)(UINTN)LogEnd) {
 
     EventSize = GetCompressedTCGEventSize (EmptySlot);
     if (EventSize == 0) {
@@ -302,6 +360,7 @@ TpmLogSpecIDEvent (
   TCG_EfiSpecIdEventAlgorithmSize        *DigestSize;
   UINT32                                 NumberOfAlgorithms;
   UINT8                                  *VendorInfoSize;
+  TPM_LIB_PRIVATE_DATA                   *TpmLibData;
 
   GetTCGLasa (&Lasa, &Laml);
 
@@ -365,6 +424,12 @@ TpmLogSpecIDEvent (
                              + sizeof (UINT8)
                              + *VendorInfoSize;
 
+  // Log was (re)initialized, reset the free offset
+  TpmLibData = TpmLibGetPrivateData ();
+  if (TpmLibData != NULL) {
+    TpmLibData->LogAreaFreeOffset = sizeof (*FirstPcrEvent) + FirstPcrEvent->EventSize;
+  }
+
   return RETURN_SUCCESS;
 }
 
@@ -389,9 +454,8 @@ TpmLogEvent (
   UINT32                Lasa;            //LogAreaStartAddress
   UINT32                Laml;            //LogAreaMinimumLength
   UINT32                EventSize;
-
-  TCG_PCR_EVENT2_HDR *EmptySlot;
-  TCG_PCR_EVENT_HDR *FirstEvent;
+  UINT32                FreeOffset;
+  TPM_LIB_PRIVATE_DATA  *TpmLibData;
 
   GetTCGLasa (&Lasa, &Laml);
 
@@ -400,29 +464,21 @@ TpmLogEvent (
     return RETURN_BUFFER_TOO_SMALL;
   }
 
-
-  // Navigate log area to Locate the empty space for new event log
-  // Note : First Event is of type TPM 1.2 (TCG_PCR_EVENT_HDR)
-
-  FirstEvent = (TCG_PCR_EVENT_HDR *)(UINTN)Lasa;
-  EmptySlot  = (TCG_PCR_EVENT2_HDR *)
-               ((UINT8 *)FirstEvent + sizeof (TCG_PCR_EVENT_HDR) + FirstEvent->EventSize);
-
-  while (EmptySlot < (TCG_PCR_EVENT2_HDR *)(UINTN)(Lasa + Laml - 1)) {
-    EventSize = GetCompressedTCGEventSize (EmptySlot);
-    if (EventSize == 0) {
-      break;
-    } else {
-      EmptySlot = (TCG_PCR_EVENT2_HDR *) ((UINT8 *)EmptySlot + EventSize);
-    }
+  TpmLibData = TpmLibGetPrivateData ();
+  if (TpmLibData == NULL) {
+    return RETURN_NOT_FOUND;
   }
 
+  // Locate the empty space for new event log from the cached index
+  FreeOffset = GetTCGLogFreeOffset (TpmLibData);
+
   // Before adding new event, check if there is enough space available.
   EventSize = GetUnCompressedTCGEventSize (EventHdr);
 
-  if (((UINT8 *)EmptySlot + EventSize) <= (UINT8 *)(UINTN)(Lasa + Laml - 1)) {
+  if (FreeOffset + EventSize <= Laml - 1) {
     // Add the new event in the TCG 2.0 log area
-    AddEventTCGLog ((UINT8 *)EmptySlot, EventHdr, EventData);
+    AddEventTCGLog ((UINT8 *)(UINTN)(Lasa + FreeOffset), EventHdr, EventData);
+    TpmLibData->LogAreaFreeOffset = FreeOffset + EventSize;
   } else {
     DEBUG ((DEBUG_WARN, "Insufficient space : Event not logged in TCG Event log!!\n"));
   }
@@ -430,6 +486,7 @@ TpmLogEvent (
   return RETURN_SUCCESS;
 }
 
+
 /**
   Log Startup Locality event in TCG event log.
 
@@ -187,6 +187,7 @@ TpmLibSetEventLogData (
 
   PrivateData->LogAreaStartAddress = Lasa;
   PrivateData->LogAreaMinLength = Laml;
+  PrivateData->LogAreaFreeOffset = 0;
   Status = SetLibraryData (PcdGet8 (PcdTpmLibId), PrivateData, sizeof (TPM_LIB_PRIVATE_DATA));
   return Status;
 }
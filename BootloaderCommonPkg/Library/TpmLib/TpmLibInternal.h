@@ -13,7 +13,12 @@ typedef struct {
   UINT32 ActivePcrBanks;
   UINT64 LogAreaStartAddress;
   UINT32 LogAreaMinLength;
-
+  //
+  // Free offset in the TCG event log, relative to LogAreaStartAddress so that
+  // it remains valid when the private data is migrated between stages.
+  // Zero means the offset has not been located yet.
+  //
+  UINT32 LogAreaFreeOffset;
 } TPM_LIB_PRIVATE_DATA;
 
 
@@ -181,7 +181,6 @@ BotDataPhase (
   UINT8           EndpointAddr;
   UINTN           Remain;
   UINTN           Increment;
-  UINT32          MaxPacketLen;
   UINT8           *BufferPtr;
   UINTN           TransferredSize;
 
@@ -192,22 +191,21 @@ BotDataPhase (
   TransferredSize = 0;
 
   //
-  // retrieve the the max packet length of the given endpoint
+  // retrieve the endpoint of the given direction
   //
   if (Direction == EfiUsbDataIn) {
-    MaxPacketLen  = (PeiBotDev->BulkInEndpoint)->MaxPacketSize;
     EndpointAddr  = (PeiBotDev->BulkInEndpoint)->EndpointAddress;
   } else {
-    MaxPacketLen  = (PeiBotDev->BulkOutEndpoint)->MaxPacketSize;
     EndpointAddr  = (PeiBotDev->BulkOutEndpoint)->EndpointAddress;
   }
 
   while (Remain > 0) {
     //
-    // Using 15 packets to avoid Bitstuff error
+    // The xHCI host controller splits a large bulk transfer into TRBs itself,
+    // so a whole read command moves in one transfer.
     //
-    if (Remain > 16 * MaxPacketLen) {
-      Increment = 16 * MaxPacketLen;
+    if (Remain > USB_BOT_SS_MAX_TRANSFER_SIZE) {
+      Increment = USB_BOT_SS_MAX_TRANSFER_SIZE;
     } else {
       Increment = Remain;
     }
@@ -21,6 +21,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/BaseMemoryLib.h>
 
 #include <IndustryStandard/Atapi.h>
+#include <IndustryStandard/Scsi.h>
 
 #include <Library/MemoryAllocationLib.h>
 
@@ -58,6 +59,13 @@ typedef struct {
 #define CSWSIG  0x53425355
 #define CBWSIG  0x43425355
 
+//
+// Largest data transfer of one read command. Many mass storage devices are
+// known to handle 240 blocks of 512 bytes; SuperSpeed devices take 1MB.
+//
+#define USB_BOT_MAX_TRANSFER_SIZE     (240 * 512)
+#define USB_BOT_SS_MAX_TRANSFER_SIZE  SIZE_1MB
+
 /**
   Sends out ATAPI Inquiry Packet Command to the specified device. This command will
   return INQUIRY data of the device.
@@ -149,9 +157,9 @@ PeiUsbReadFormattedCapacity (
   );
 
 /**
-  Execute Read(10) ATAPI command on a specific SCSI target.
+  Execute Read(10) or Read(16) ATAPI command on a specific SCSI target.
 
-  Executes the ATAPI Read(10) command on the ATAPI target specified by PeiBotDevice.
+  Executes the ATAPI Read command on the ATAPI target specified by PeiBotDevice.
 
   @param PeiServices       The pointer of EFI_PEI_SERVICES.
   @param PeiBotDevice      The pointer to PEI_BOT_DEVICE instance.
@@ -164,7 +172,7 @@ PeiUsbReadFormattedCapacity (
 
 **/
 EFI_STATUS
-PeiUsbRead10 (
+PeiUsbRead (
   IN  EFI_PEI_SERVICES  **PeiServices,
   IN  PEI_BOT_DEVICE    *PeiBotDevice,
   IN  VOID              *Buffer,
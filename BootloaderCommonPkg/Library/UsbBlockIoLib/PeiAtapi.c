@@ -216,6 +216,58 @@ PeiUsbRequestSense (
   return EFI_SUCCESS;
 }
 
+/**
+  Sends out SCSI Read Capacity(16) Command to the specified device, to get
+  the capacity of media with more than 0xFFFFFFFF blocks.
+
+  @param PeiServices    The pointer of EFI_PEI_SERVICES.
+  @param PeiBotDevice   The pointer to PEI_BOT_DEVICE instance.
+
+  @retval EFI_SUCCESS           Command executed successfully.
+  @retval EFI_DEVICE_ERROR      Some device errors happen.
+
+**/
+STATIC
+EFI_STATUS
+PeiUsbReadCapacity16 (
+  IN  EFI_PEI_SERVICES  **PeiServices,
+  IN  PEI_BOT_DEVICE    *PeiBotDevice
+  )
+{
+  EFI_STATUS                       Status;
+  UINT8                            Cdb[16];
+  EFI_SCSI_DISK_CAPACITY_DATA16    Data;
+
+  ZeroMem (&Data, sizeof (EFI_SCSI_DISK_CAPACITY_DATA16));
+  ZeroMem (Cdb, sizeof (Cdb));
+
+  Cdb[0]  = EFI_SCSI_OP_READ_CAPACITY16;
+  Cdb[1]  = 0x10;          // Service Action for Read Capacity(16).
+  Cdb[13] = 0x20;          // The maximum number of bytes for returned data.
+
+  //
+  // send command packet
+  //
+  Status = PeiAtapiCommand (
+             PeiServices,
+             PeiBotDevice,
+             Cdb,
+             (UINT8) sizeof (Cdb),
+             (VOID *) &Data,
+             sizeof (EFI_SCSI_DISK_CAPACITY_DATA16),
+             EfiUsbDataIn,
+             PcdGet16 (PcdUsbCmdTimeout)
+             );
+
+  if (EFI_ERROR (Status)) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  PeiBotDevice->Media.LastBlock = (EFI_PEI_LBA) SwapBytes64 (ReadUnaligned64 ((UINT64 *) &Data.LastLba7));
+
+  return EFI_SUCCESS;
+}
+
 /**
   Sends out ATAPI Read Capacity Packet Command to the specified device.
   This command will return the information regarding the capacity of the
@@ -263,13 +315,14 @@ PeiUsbReadCapacity (
   }
   LastBlock = ((UINT32) Data.LastLba3 << 24) | (Data.LastLba2 << 16) | (Data.LastLba1 << 8) | Data.LastLba0;
 
+  PeiBotDevice->Media.LastBlock    = LastBlock;
+  PeiBotDevice->Media.MediaPresent = TRUE;
+
   if (LastBlock == 0xFFFFFFFF) {
     DEBUG ((DEBUG_VERBOSE, "The usb device LBA count is larger than 0xFFFFFFFF!\n"));
+    PeiUsbReadCapacity16 (PeiServices, PeiBotDevice);
   }
 
-  PeiBotDevice->Media.LastBlock    = LastBlock;
-  PeiBotDevice->Media.MediaPresent = TRUE;
-
   return EFI_SUCCESS;
 }
 
@@ -345,9 +398,12 @@ PeiUsbReadFormattedCapacity (
 }
 
 /**
-  Execute Read(10) ATAPI command on a specific SCSI target.
+  Execute Read(10) or Read(16) ATAPI command on a specific SCSI target.
 
-  Executes the ATAPI Read(10) command on the ATAPI target specified by PeiBotDevice.
+  Executes the ATAPI Read command on the ATAPI target specified by PeiBotDevice.
+  Read(16) is only used for blocks beyond the 32-bit LBA range. Each command
+  transfers up to USB_BOT_MAX_TRANSFER_SIZE, or USB_BOT_SS_MAX_TRANSFER_SIZE
+  for SuperSpeed devices.
 
   @param PeiServices       The pointer of EFI_PEI_SERVICES.
   @param PeiBotDevice      The pointer to PEI_BOT_DEVICE instance.
@@ -360,7 +416,7 @@ PeiUsbReadFormattedCapacity (
 
 **/
 EFI_STATUS
-PeiUsbRead10 (
+PeiUsbRead (
   IN  EFI_PEI_SERVICES  **PeiServices,
   IN  PEI_BOT_DEVICE    *PeiBotDevice,
   IN  VOID              *Buffer,
@@ -368,66 +424,63 @@ PeiUsbRead10 (
   IN  UINTN             NumberOfBlocks
   )
 {
-  ATAPI_PACKET_COMMAND  Packet;
-  ATAPI_READ10_CMD      *Read10Packet;
-  UINT16                MaxBlock;
-  UINT32                BlocksRemaining;
-  UINT16                SectorCount;
-  UINT32                Lba32;
+  UINT8                 Cdb[16];
+  UINT8                 CdbSize;
+  UINT32                MaxTransferSize;
+  UINT32                MaxBlock;
+  UINTN                 BlocksRemaining;
+  UINT32                SectorCount;
   UINT32                BlockSize;
   UINT32                ByteCount;
   VOID                  *PtrBuffer;
   EFI_STATUS            Status;
   UINT16                TimeOut;
 
-  //
-  // prepare command packet for the Inquiry Packet Command.
-  //
-  ZeroMem (&Packet, sizeof (ATAPI_PACKET_COMMAND));
-  Read10Packet    = &Packet.Read10;
-  Lba32           = (UINT32) Lba;
   PtrBuffer       = Buffer;
-
   BlockSize       = (UINT32) PeiBotDevice->Media.BlockSize;
 
-  MaxBlock        = (UINT16) (65535 / BlockSize);
-  BlocksRemaining = (UINT32) NumberOfBlocks;
+  //
+  // A bulk endpoint with 1024-byte packets means a SuperSpeed device.
+  //
+  if (PeiBotDevice->BulkInEndpoint->MaxPacketSize >= 1024) {
+    MaxTransferSize = USB_BOT_SS_MAX_TRANSFER_SIZE;
+  } else {
+    MaxTransferSize = USB_BOT_MAX_TRANSFER_SIZE;
+  }
+  MaxBlock        = MaxTransferSize / BlockSize;
+  BlocksRemaining = NumberOfBlocks;
 
   Status          = EFI_SUCCESS;
   while (BlocksRemaining > 0) {
 
     if (BlocksRemaining <= MaxBlock) {
 
-      SectorCount = (UINT16)BlocksRemaining;
+      SectorCount = (UINT32)BlocksRemaining;
 
     } else {
 
       SectorCount = MaxBlock;
     }
-    //
-    // fill the Packet data structure
-    //
-    Read10Packet->opcode = ATA_CMD_READ_10;
 
     //
-    // Lba0 ~ Lba3 specify the start logical block address of the data transfer.
-    // Lba0 is MSB, Lba3 is LSB
+    // fill the command descriptor block, LBA and transfer length are big endian
     //
-    Read10Packet->Lba3  = (UINT8) (Lba32 & 0xff);
-    Read10Packet->Lba2  = (UINT8) (Lba32 >> 8);
-    Read10Packet->Lba1  = (UINT8) (Lba32 >> 16);
-    Read10Packet->Lba0  = (UINT8) (Lba32 >> 24);
-
-    //
-    // TranLen0 ~ TranLen1 specify the transfer length in block unit.
-    // TranLen0 is MSB, TranLen is LSB
-    //
-    Read10Packet->TranLen1  = (UINT8) (SectorCount & 0xff);
-    Read10Packet->TranLen0  = (UINT8) (SectorCount >> 8);
+    ZeroMem (Cdb, sizeof (Cdb));
+    if (Lba + SectorCount - 1 > MAX_UINT32) {
+      CdbSize = 16;
+      Cdb[0]  = EFI_SCSI_OP_READ16;
+      WriteUnaligned64 ((UINT64 *) &Cdb[2], SwapBytes64 (Lba));
+      WriteUnaligned32 ((UINT32 *) &Cdb[10], SwapBytes32 (SectorCount));
+    } else {
+      CdbSize = (UINT8) sizeof (ATAPI_PACKET_COMMAND);
+      Cdb[0]  = ATA_CMD_READ_10;
+      WriteUnaligned32 ((UINT32 *) &Cdb[2], SwapBytes32 ((UINT32) Lba));
+      WriteUnaligned16 ((UINT16 *) &Cdb[7], SwapBytes16 ((UINT16) SectorCount));
+    }
 
     ByteCount               = SectorCount * BlockSize;
 
-    TimeOut                 = (UINT16) (SectorCount * 2000);
+    TimeOut                 = (UINT16) MIN (SectorCount * 2000, MAX_UINT16);
 
     //
     // send command packet
@@ -435,8 +488,8 @@ PeiUsbRead10 (
     Status = PeiAtapiCommand (
                PeiServices,
                PeiBotDevice,
-               &Packet,
-               (UINT8) sizeof (ATAPI_PACKET_COMMAND),
+               Cdb,
+               CdbSize,
                (VOID *) PtrBuffer,
                ByteCount,
                EfiUsbDataIn,
@@ -447,8 +500,8 @@ PeiUsbRead10 (
       return Status;
     }
 
-    Lba32 += SectorCount;
-    PtrBuffer       = (UINT8 *) PtrBuffer + SectorCount * BlockSize;
+    Lba            += SectorCount;
+    PtrBuffer       = (UINT8 *) PtrBuffer + ByteCount;
     BlocksRemaining = BlocksRemaining - SectorCount;
   }
 
@@ -390,7 +390,7 @@ BotReadBlocks (
                PeiBotDev
                );
     if (Status == EFI_SUCCESS) {
-      Status = PeiUsbRead10 (
+      Status = PeiUsbRead (
                  PeiServices,
                  PeiBotDev,
                  Buffer,
@@ -439,7 +439,7 @@ BotReadBlocks (
       return EFI_INVALID_PARAMETER;
     }
 
-    Status = PeiUsbRead10 (
+    Status = PeiUsbRead (
                PeiServices,
                PeiBotDev,
                Buffer,
@@ -464,7 +464,7 @@ BotReadBlocks (
       return EFI_SUCCESS;
     }
 
-    Status = PeiUsbRead10 (
+    Status = PeiUsbRead (
                PeiServices,
                PeiBotDev,
                Buffer,
@@ -497,7 +497,9 @@ PeiDoHubConfig (
 }
 
 /**
-  Send reset signal over the given root hub port.
+  Send reset signal over the given hub port.
+
+  The caller must have waited for the connect debounce time of the port.
 
   @param  PeiServices    General-purpose services that are available to every PEIM.
   @param  UsbIoPpi       Indicates the PEI_USB_IO_PPI instance.
@@ -515,8 +517,6 @@ PeiResetHubPort (
   UINTN               Index;
   EFI_USB_PORT_STATUS HubPortStatus;
 
-  MicroSecondDelay (100 * 1000);
-
   //
   // reset root port
   //
@@ -528,13 +528,9 @@ PeiResetHubPort (
     );
 
   //
-  // Drive the reset signal for worst 20ms. Check USB 2.0 Spec
-  // section 7.1.7.5 for timing requirements.
-  //
-  MicroSecondDelay (USB_SET_PORT_RESET_STALL);
-
-  //
-  // Check USB_PORT_STAT_C_RESET bit to see if the resetting state is done.
+  // The hub drives the reset signal for 10 to 20ms, see USB 2.0 Spec
+  // section 11.5.1.5. Check USB_PORT_STAT_C_RESET bit to see if the
+  // resetting state is done instead of waiting for the worst case.
   //
   ZeroMem (&HubPortStatus, sizeof (EFI_USB_PORT_STATUS));
 
@@ -572,8 +568,6 @@ PeiResetHubPort (
     EfiUsbPortResetChange
     );
 
-  MicroSecondDelay (1 * 1000);
-
   PeiHubClearPortFeature (
     PeiServices,
     UsbIoPpi,
@@ -602,7 +596,7 @@ PeiResetHubPort (
     EfiUsbPortEnableChange
     );
 
-  MicroSecondDelay (10 * 1000);
+  MicroSecondDelay (USB_PORT_RESET_RECOVERY_STALL);
 
   return;
 }
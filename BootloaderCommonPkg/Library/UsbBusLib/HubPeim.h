@@ -241,7 +241,9 @@ PeiDoHubConfig (
   );
 
 /**
-  Send reset signal over the given root hub port.
+  Send reset signal over the given hub port.
+
+  The caller must have waited for the connect debounce time of the port.
 
   @param  PeiServices    General-purpose services that are available to every PEIM.
   @param  UsbIoPpi       Indicates the PEI_USB_IO_PPI instance.
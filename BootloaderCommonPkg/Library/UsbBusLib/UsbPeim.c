@@ -141,9 +141,11 @@ PeiHubEnumeration (
   PEI_USB_DEVICE        *NewPeiUsbDevice;
   UINTN                 InterfaceIndex;
   UINTN                 EndpointIndex;
+  BOOLEAN               Debounced;
 
 
   UsbIoPpi    = &PeiUsbDevice->UsbIoPpi;
+  Debounced   = FALSE;
 
   DEBUG ((DEBUG_VERBOSE, "PeiHubEnumeration: DownStreamPortNo: %x\n", PeiUsbDevice->DownStreamPortNo));
 
@@ -222,7 +224,12 @@ PeiHubEnumeration (
             ((PortStatus.PortStatus & (USB_PORT_STAT_CONNECTION | USB_PORT_STAT_ENABLE)) == 0)) {
           //
           // If the port already has reset change flag and is connected and enabled, skip the port reset logic.
+          // The ports were powered together, so one debounce time covers all of them.
           //
+          if (!Debounced) {
+            MicroSecondDelay (USB_PORT_CONNECT_DEBOUNCE_STALL);
+            Debounced = TRUE;
+          }
           PeiResetHubPort (PeiServices, UsbIoPpi, (UINT8) (Index + 1));
 
           Status = PeiHubGetPortStatus (
@@ -392,9 +399,400 @@ PeiHubEnumeration (
   return EFI_SUCCESS;
 }
 
+/**
+  Get the status of a root hub port.
+
+  @param  PeiServices       Describes the list of possible PEI Services.
+  @param  UsbHcPpi          The pointer of PEI_USB_HOST_CONTROLLER_PPI instance.
+  @param  Usb2HcPpi         The pointer of PEI_USB2_HOST_CONTROLLER_PPI instance.
+  @param  PortNum           The root hub port number.
+  @param  PortStatus        Returns the port status.
+
+  @retval EFI_SUCCESS       The port status is returned.
+  @retval Others            Failed to get the port status.
+
+**/
+STATIC
+EFI_STATUS
+GetRootPortStatus (
+  IN EFI_PEI_SERVICES               **PeiServices,
+  IN PEI_USB_HOST_CONTROLLER_PPI    *UsbHcPpi,
+  IN PEI_USB2_HOST_CONTROLLER_PPI   *Usb2HcPpi,
+  IN UINT8                          PortNum,
+  OUT EFI_USB_PORT_STATUS           *PortStatus
+  )
+{
+  if (Usb2HcPpi != NULL) {
+    return Usb2HcPpi->GetRootHubPortStatus (PeiServices, Usb2HcPpi, PortNum, PortStatus);
+  }
+  return UsbHcPpi->GetRootHubPortStatus (PeiServices, UsbHcPpi, PortNum, PortStatus);
+}
+
+/**
+  Set a feature of a root hub port.
+
+  @param  PeiServices       Describes the list of possible PEI Services.
+  @param  UsbHcPpi          The pointer of PEI_USB_HOST_CONTROLLER_PPI instance.
+  @param  Usb2HcPpi         The pointer of PEI_USB2_HOST_CONTROLLER_PPI instance.
+  @param  PortNum           The root hub port number.
+  @param  PortFeature       The feature to set.
+
+  @retval EFI_SUCCESS       The feature is set.
+  @retval Others            Failed to set the feature.
+
+**/
+STATIC
+EFI_STATUS
+SetRootPortFeature (
+  IN EFI_PEI_SERVICES               **PeiServices,
+  IN PEI_USB_HOST_CONTROLLER_PPI    *UsbHcPpi,
+  IN PEI_USB2_HOST_CONTROLLER_PPI   *Usb2HcPpi,
+  IN UINT8                          PortNum,
+  IN EFI_USB_PORT_FEATURE           PortFeature
+  )
+{
+  if (Usb2HcPpi != NULL) {
+    return Usb2HcPpi->SetRootHubPortFeature (PeiServices, Usb2HcPpi, PortNum, PortFeature);
+  }
+  return UsbHcPpi->SetRootHubPortFeature (PeiServices, UsbHcPpi, PortNum, PortFeature);
+}
+
+/**
+  Clear a feature of a root hub port.
+
+  @param  PeiServices       Describes the list of possible PEI Services.
+  @param  UsbHcPpi          The pointer of PEI_USB_HOST_CONTROLLER_PPI instance.
+  @param  Usb2HcPpi         The pointer of PEI_USB2_HOST_CONTROLLER_PPI instance.
+  @param  PortNum           The root hub port number.
+  @param  PortFeature       The feature to clear.
+
+  @retval EFI_SUCCESS       The feature is cleared.
+  @retval Others            Failed to clear the feature.
+
+**/
+STATIC
+EFI_STATUS
+ClearRootPortFeature (
+  IN EFI_PEI_SERVICES               **PeiServices,
+  IN PEI_USB_HOST_CONTROLLER_PPI    *UsbHcPpi,
+  IN PEI_USB2_HOST_CONTROLLER_PPI   *Usb2HcPpi,
+  IN UINT8                          PortNum,
+  IN EFI_USB_PORT_FEATURE           PortFeature
+  )
+{
+  if (Usb2HcPpi != NULL) {
+    return Usb2HcPpi->ClearRootHubPortFeature (PeiServices, Usb2HcPpi, PortNum, PortFeature);
+  }
+  return UsbHcPpi->ClearRootHubPortFeature (PeiServices, UsbHcPpi, PortNum, PortFeature);
+}
+
+/**
+  Wait for the reset of a root hub port to finish and enable the port.
+
+  The reset must have been started by setting EfiUsbPortReset. Host controllers
+  that time the reset themselves report its end right away. For the others the
+  reset is ended by software once it was driven for USB_SET_ROOT_PORT_RESET_STALL.
+
+  @param  PeiServices       Describes the list of possible PEI Services.
+  @param  UsbHcPpi          The pointer of PEI_USB_HOST_CONTROLLER_PPI instance.
+  @param  Usb2HcPpi         The pointer of PEI_USB2_HOST_CONTROLLER_PPI instance.
+  @param  PortNum           The port being reset.
+  @param  RetryIndex        The retry times.
+
+  @retval EFI_SUCCESS       The reset finished and the port is enabled.
+  @retval EFI_TIMEOUT       The reset did not finish in time.
+  @retval Others            Failed to access the port.
+
+**/
+STATIC
+EFI_STATUS
+FinishRootPortReset (
+  IN EFI_PEI_SERVICES               **PeiServices,
+  IN PEI_USB_HOST_CONTROLLER_PPI    *UsbHcPpi,
+  IN PEI_USB2_HOST_CONTROLLER_PPI   *Usb2HcPpi,
+  IN UINT8                          PortNum,
+  IN UINT8                          RetryIndex
+  )
+{
+  EFI_STATUS             Status;
+  UINTN                  Index;
+  UINTN                  DriveLoop;
+  EFI_USB_PORT_STATUS    PortStatus;
+
+  //
+  // USB host controller won't clear the RESET bit until
+  // reset is actually finished.
+  //
+  ZeroMem (&PortStatus, sizeof (EFI_USB_PORT_STATUS));
+
+  DriveLoop = USB_SET_ROOT_PORT_RESET_STALL / USB_WAIT_PORT_STS_CHANGE_STALL;
+  for (Index = 0; Index < DriveLoop + USB_WAIT_PORT_STS_CHANGE_LOOP; Index++) {
+    Status = GetRootPortStatus (PeiServices, UsbHcPpi, Usb2HcPpi, PortNum, &PortStatus);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    if (!USB_BIT_IS_SET (PortStatus.PortStatus, USB_PORT_STAT_RESET)) {
+      break;
+    }
+
+    if (Index == DriveLoop) {
+      //
+      // The reset signal was driven for at least 50ms. Check USB 2.0 Spec
+      // section 7.1.7.5 for timing requirements.
+      //
+      Status = ClearRootPortFeature (PeiServices, UsbHcPpi, Usb2HcPpi, PortNum, EfiUsbPortReset);
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "ClearRootHubPortFeature EfiUsbPortReset Failed\n"));
+        return Status;
+      }
+    }
+
+    MicroSecondDelay (USB_WAIT_PORT_STS_CHANGE_STALL);
+  }
+
+  if (Index == DriveLoop + USB_WAIT_PORT_STS_CHANGE_LOOP) {
+    DEBUG ((DEBUG_ERROR, "ResetRootPort: reset not finished in time on port %d\n", PortNum));
+    return EFI_TIMEOUT;
+  }
+
+  ClearRootPortFeature (PeiServices, UsbHcPpi, Usb2HcPpi, PortNum, EfiUsbPortResetChange);
+  ClearRootPortFeature (PeiServices, UsbHcPpi, Usb2HcPpi, PortNum, EfiUsbPortConnectChange);
+
+  //
+  // Set port enable
+  //
+  SetRootPortFeature (PeiServices, UsbHcPpi, Usb2HcPpi, PortNum, EfiUsbPortEnable);
+  ClearRootPortFeature (PeiServices, UsbHcPpi, Usb2HcPpi, PortNum, EfiUsbPortEnableChange);
+
+  //
+  // Give the device its reset recovery time, and back off further on retries.
+  //
+  MicroSecondDelay (USB_PORT_RESET_RECOVERY_STALL + RetryIndex * USB_SET_ROOT_PORT_RESET_STALL);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Create and configure the device attached to a root hub port.
+
+  The port must be reset and enabled already. A device that fails to
+  configure is skipped.
+
+  @param  PeiServices            Describes the list of possible PEI Services.
+  @param  UsbHcPpi               The pointer of PEI_USB_HOST_CONTROLLER_PPI instance.
+  @param  Usb2HcPpi              The pointer of PEI_USB2_HOST_CONTROLLER_PPI instance.
+  @param  PortNum                The root hub port number.
+  @param  PortStatus             The status of the enabled port.
+  @param  CurrentAddress         The DeviceAddress of usb device.
+
+  @retval EFI_SUCCESS            The port is handled.
+  @retval EFI_OUT_OF_RESOURCES   Can't allocate memory resource.
+  @retval Others                 Hub configuration failed.
+
+**/
+STATIC
+EFI_STATUS
+PeiUsbConfigureRootPortDevice (
+  IN EFI_PEI_SERVICES               **PeiServices,
+  IN PEI_USB_HOST_CONTROLLER_PPI    *UsbHcPpi,
+  IN PEI_USB2_HOST_CONTROLLER_PPI   *Usb2HcPpi,
+  IN UINT8                          PortNum,
+  IN EFI_USB_PORT_STATUS            *PortStatus,
+  IN OUT UINT8                      *CurrentAddress
+  )
+{
+  EFI_STATUS            Status;
+  PEI_USB_DEVICE        *PeiUsbDevice;
+  UINTN                 MemPages;
+  EFI_PHYSICAL_ADDRESS  AllocateAddress;
+  UINTN                 InterfaceIndex;
+  UINTN                 EndpointIndex;
+
+  MemPages = sizeof (PEI_USB_DEVICE) / EFI_PAGE_SIZE + 1;
+  Status = PeiServicesAllocatePages (
+             EfiBootServicesCode,
+             MemPages,
+             &AllocateAddress
+             );
+  if (EFI_ERROR (Status)) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  PeiUsbDevice = (PEI_USB_DEVICE *) ((UINTN) AllocateAddress);
+  ZeroMem (PeiUsbDevice, sizeof (PEI_USB_DEVICE));
+
+  PeiUsbDevice->Signature         = PEI_USB_DEVICE_SIGNATURE;
+  PeiUsbDevice->DeviceAddress     = 0;
+  PeiUsbDevice->MaxPacketSize0    = 8;
+  PeiUsbDevice->DataToggle        = 0;
+  CopyMem (
+    & (PeiUsbDevice->UsbIoPpi),
+    &mUsbIoPpi,
+    sizeof (PEI_USB_IO_PPI)
+    );
+  CopyMem (
+    & (PeiUsbDevice->UsbIoPpiList),
+    &mUsbIoPpiList,
+    sizeof (EFI_PEI_PPI_DESCRIPTOR)
+    );
+  PeiUsbDevice->UsbIoPpiList.Ppi  = &PeiUsbDevice->UsbIoPpi;
+  PeiUsbDevice->AllocateAddress   = (UINTN) AllocateAddress;
+  PeiUsbDevice->UsbHcPpi          = UsbHcPpi;
+  PeiUsbDevice->Usb2HcPpi         = Usb2HcPpi;
+  PeiUsbDevice->IsHub             = 0x0;
+  PeiUsbDevice->DownStreamPortNo  = 0x0;
+  PeiUsbDevice->Port              = PortNum;
+  PeiUsbDevice->Parent            = NULL;
+
+  PeiUsbDevice->DeviceSpeed = (UINT8) PeiUsbGetDeviceSpeed (PortStatus->PortStatus);
+  DEBUG ((DEBUG_VERBOSE, "Device Speed =%d\n", PeiUsbDevice->DeviceSpeed));
+
+  if (USB_BIT_IS_SET (PortStatus->PortStatus, USB_PORT_STAT_SUPER_SPEED)) {
+    PeiUsbDevice->MaxPacketSize0 = 512;
+  } else if (USB_BIT_IS_SET (PortStatus->PortStatus, USB_PORT_STAT_HIGH_SPEED)) {
+    PeiUsbDevice->MaxPacketSize0 = 64;
+  } else if (USB_BIT_IS_SET (PortStatus->PortStatus, USB_PORT_STAT_LOW_SPEED)) {
+    PeiUsbDevice->MaxPacketSize0 = 8;
+  } else {
+    PeiUsbDevice->MaxPacketSize0 = 8;
+  }
+
+  //
+  // Configure that Usb Device
+  //
+  Status = PeiConfigureUsbDevice (
+             PeiServices,
+             PeiUsbDevice,
+             PortNum,
+             CurrentAddress
+             );
+
+  if (EFI_ERROR (Status)) {
+    FreePages (PeiUsbDevice, MemPages);
+    return EFI_SUCCESS;
+  }
+  DEBUG ((DEBUG_VERBOSE, "PeiUsbEnumeration: PeiConfigureUsbDevice Success\n"));
+
+  if (PeiUsbDevice->InterfaceDesc->InterfaceClass == 0x09) {
+    PeiUsbDevice->IsHub = 0x1;
+
+    Status = PeiDoHubConfig (PeiServices, PeiUsbDevice);
+    if (EFI_ERROR (Status)) {
+      FreePages (PeiUsbDevice, MemPages);
+      return Status;
+    }
+
+    Status = PeiHubEnumeration (PeiServices, PeiUsbDevice, CurrentAddress);
+    if (EFI_ERROR (Status)) {
+      FreePages (PeiUsbDevice, MemPages);
+      return Status;
+    }
+  }
+
+  //
+  // Install UsbIo PPI for the new device only after successful configuration and hub enumeration
+  //
+  Status = PeiServicesInstallPpi (&PeiUsbDevice->UsbIoPpiList);
+  if (EFI_ERROR (Status)) {
+    FreePages (PeiUsbDevice, MemPages);
+    return EFI_SUCCESS;
+  }
+
+  {
+    // Keep the original (first-interface) device pointer stable so that
+    // (a) the loop condition is never evaluated against freed memory, and
+    // (b) every clone is always made from the same source, giving a
+    //     constant DataDelta and avoiding chained-delta fragility.
+    PEI_USB_DEVICE  *BaseDevice    = PeiUsbDevice;
+    PEI_USB_DEVICE  *ClonedDevice;
+    UINTN            NumInterfaces = BaseDevice->ConfigDesc->NumInterfaces;
+    UINTN            IfIdx;
+    UINTN            EpIdx;
+    INTN             DataDelta;
+
+    for (InterfaceIndex = 1; InterfaceIndex < NumInterfaces; InterfaceIndex++) {
+      //
+      // Clone the base (first-interface) device for each additional interface.
+      //
+      MemPages = sizeof (PEI_USB_DEVICE) / EFI_PAGE_SIZE + 1;
+      Status = PeiServicesAllocatePages (
+                 EfiBootServicesCode,
+                 MemPages,
+                 &AllocateAddress
+                 );
+      if (EFI_ERROR (Status)) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+
+      CopyMem ((VOID *) (UINTN)AllocateAddress, BaseDevice, sizeof (PEI_USB_DEVICE));
+      ClonedDevice = (PEI_USB_DEVICE *) ((UINTN) AllocateAddress);
+      ClonedDevice->AllocateAddress  = (UINTN) AllocateAddress;
+      ClonedDevice->UsbIoPpiList.Ppi = &ClonedDevice->UsbIoPpi;
+
+      // Relocate all ConfigurationData-relative pointers from the base
+      // allocation to the equivalent offset in the new copy.
+      DataDelta = (INTN)ClonedDevice->ConfigurationData -
+                  (INTN)BaseDevice->ConfigurationData;
+      if (ClonedDevice->ConfigDesc != NULL) {
+        ClonedDevice->ConfigDesc = (EFI_USB_CONFIG_DESCRIPTOR *)((UINT8 *)ClonedDevice->ConfigDesc + DataDelta);
+      }
+
+      for (IfIdx = 0; IfIdx < MAX_INTERFACE; IfIdx++) {
+        if (ClonedDevice->InterfaceDescList[IfIdx] != NULL) {
+          ClonedDevice->InterfaceDescList[IfIdx] =
+            (EFI_USB_INTERFACE_DESCRIPTOR *)((UINT8 *)ClonedDevice->InterfaceDescList[IfIdx] + DataDelta);
+        }
+        for (EpIdx = 0; EpIdx < MAX_ENDPOINT; EpIdx++) {
+          if (ClonedDevice->EndpointDescList[IfIdx][EpIdx] != NULL) {
+            ClonedDevice->EndpointDescList[IfIdx][EpIdx] =
+              (EFI_USB_ENDPOINT_DESCRIPTOR *)((UINT8 *)ClonedDevice->EndpointDescList[IfIdx][EpIdx] + DataDelta);
+          }
+        }
+      }
+
+      ClonedDevice->InterfaceDesc = ClonedDevice->InterfaceDescList[InterfaceIndex];
+      for (EndpointIndex = 0; EndpointIndex < ClonedDevice->InterfaceDesc->NumEndpoints; EndpointIndex++) {
+        ClonedDevice->EndpointDesc[EndpointIndex] = ClonedDevice->EndpointDescList[InterfaceIndex][EndpointIndex];
+      }
+
+      if (ClonedDevice->InterfaceDesc->InterfaceClass == 0x09) {
+        ClonedDevice->IsHub = 0x1;
+
+        Status = PeiDoHubConfig (PeiServices, ClonedDevice);
+        if (EFI_ERROR (Status)) {
+          FreePages (ClonedDevice, MemPages);
+          return Status;
+        }
+
+        Status = PeiHubEnumeration (PeiServices, ClonedDevice, CurrentAddress);
+        if (EFI_ERROR (Status)) {
+          FreePages (ClonedDevice, MemPages);
+          return Status;
+        }
+      }
+
+      //
+      // Install UsbIo PPI for the new device only after successful configuration and hub enumeration
+      //
+      Status = PeiServicesInstallPpi (&ClonedDevice->UsbIoPpiList);
+      if (EFI_ERROR (Status)) {
+        FreePages (ClonedDevice, MemPages);
+        continue;  // safe: BaseDevice is untouched; NumInterfaces is a local
+      }
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   The enumeration routine to detect device change.
 
+  Ports whose device was reset already are configured while scanning. The
+  other connected ports share one connect debounce time and are reset all at
+  once, then their devices are configured one at a time as each reset finishes.
+
   @param  PeiServices            Describes the list of possible PEI Services.
   @param  UsbHcPpi               The pointer of PEI_USB_HOST_CONTROLLER_PPI instance.
   @param  Usb2HcPpi              The pointer of PEI_USB2_HOST_CONTROLLER_PPI instance.
@@ -415,12 +813,9 @@ PeiUsbEnumeration (
   EFI_STATUS            Status;
   UINT8                 Index;
   EFI_USB_PORT_STATUS   PortStatus;
-  PEI_USB_DEVICE        *PeiUsbDevice;
-  UINTN                 MemPages;
-  EFI_PHYSICAL_ADDRESS  AllocateAddress;
   UINT8                 CurrentAddress;
-  UINTN                 InterfaceIndex;
-  UINTN                 EndpointIndex;
+  BOOLEAN               ResetPending[MAX_UINT8];
+  UINT8                 ResetCount;
 
   CurrentAddress = 0;
   if (Usb2HcPpi != NULL) {
@@ -447,26 +842,13 @@ PeiUsbEnumeration (
 
   DEBUG ((DEBUG_VERBOSE, "PeiUsbEnumeration: NumOfRootPort: %x\n", NumOfRootPort));
 
+  ZeroMem (ResetPending, sizeof (ResetPending));
+  ResetCount = 0;
   for (Index = 0; Index < NumOfRootPort; Index++) {
     //
     // First get root port status to detect changes happen
     //
-    if (Usb2HcPpi != NULL) {
-      Status = Usb2HcPpi->GetRootHubPortStatus (
-        PeiServices,
-        Usb2HcPpi,
-        (UINT8) Index,
-        &PortStatus
-        );
-    } else {
-      Status = UsbHcPpi->GetRootHubPortStatus (
-        PeiServices,
-        UsbHcPpi,
-        (UINT8) Index,
-        &PortStatus
-        );
-    }
-
+    Status = GetRootPortStatus (PeiServices, UsbHcPpi, Usb2HcPpi, Index, &PortStatus);
     if (EFI_ERROR (Status)) {
       DEBUG ((DEBUG_ERROR, "PeiUsbEnumeration: GetRootHubPortStatus failed on port %d: %r\n", Index, Status));
       continue;
@@ -476,241 +858,72 @@ PeiUsbEnumeration (
             PortStatus.PortStatus));
     //
     // Only handle connection/enable/overcurrent/reset change.
+    // Disconnect change happen, currently we don't support
     //
-    if ((PortStatus.PortChangeStatus & (USB_PORT_STAT_C_CONNECTION | USB_PORT_STAT_C_ENABLE | USB_PORT_STAT_C_OVERCURRENT |
-                                        USB_PORT_STAT_C_RESET)) == 0) {
+    if (((PortStatus.PortChangeStatus & (USB_PORT_STAT_C_CONNECTION | USB_PORT_STAT_C_ENABLE | USB_PORT_STAT_C_OVERCURRENT |
+                                         USB_PORT_STAT_C_RESET)) == 0) ||
+        !IsPortConnect (PortStatus.PortStatus)) {
       continue;
-    } else {
-      if (IsPortConnect (PortStatus.PortStatus)) {
-        MemPages = sizeof (PEI_USB_DEVICE) / EFI_PAGE_SIZE + 1;
-        Status = PeiServicesAllocatePages (
-                   EfiBootServicesCode,
-                   MemPages,
-                   &AllocateAddress
-                   );
-        if (EFI_ERROR (Status)) {
-          return EFI_OUT_OF_RESOURCES;
-        }
-
-        PeiUsbDevice = (PEI_USB_DEVICE *) ((UINTN) AllocateAddress);
-        ZeroMem (PeiUsbDevice, sizeof (PEI_USB_DEVICE));
-
-        PeiUsbDevice->Signature         = PEI_USB_DEVICE_SIGNATURE;
-        PeiUsbDevice->DeviceAddress     = 0;
-        PeiUsbDevice->MaxPacketSize0    = 8;
-        PeiUsbDevice->DataToggle        = 0;
-        CopyMem (
-          & (PeiUsbDevice->UsbIoPpi),
-          &mUsbIoPpi,
-          sizeof (PEI_USB_IO_PPI)
-          );
-        CopyMem (
-          & (PeiUsbDevice->UsbIoPpiList),
-          &mUsbIoPpiList,
-          sizeof (EFI_PEI_PPI_DESCRIPTOR)
-          );
-        PeiUsbDevice->UsbIoPpiList.Ppi  = &PeiUsbDevice->UsbIoPpi;
-        PeiUsbDevice->AllocateAddress   = (UINTN) AllocateAddress;
-        PeiUsbDevice->UsbHcPpi          = UsbHcPpi;
-        PeiUsbDevice->Usb2HcPpi         = Usb2HcPpi;
-        PeiUsbDevice->IsHub             = 0x0;
-        PeiUsbDevice->DownStreamPortNo  = 0x0;
-        PeiUsbDevice->Port              = Index;
-        PeiUsbDevice->Parent            = NULL;
-
-        if (((PortStatus.PortChangeStatus & USB_PORT_STAT_C_RESET) == 0) ||
-            ((PortStatus.PortStatus & (USB_PORT_STAT_CONNECTION | USB_PORT_STAT_ENABLE)) == 0)) {
-          //
-          // If the port already has reset change flag and is connected and enabled, skip the port reset logic.
-          //
-          ResetRootPort (
-            PeiServices,
-            PeiUsbDevice->UsbHcPpi,
-            PeiUsbDevice->Usb2HcPpi,
-            Index,
-            0
-            );
-
-          if (Usb2HcPpi != NULL) {
-            Status = Usb2HcPpi->GetRootHubPortStatus (
-                       PeiServices,
-                       Usb2HcPpi,
-                       (UINT8) Index,
-                       &PortStatus
-                       );
-          } else {
-            Status = UsbHcPpi->GetRootHubPortStatus (
-                       PeiServices,
-                       UsbHcPpi,
-                       (UINT8) Index,
-                       &PortStatus
-                       );
-          }
-
-          if (EFI_ERROR (Status)) {
-            FreePages (PeiUsbDevice, MemPages);
-            continue;
-          }
-        } else {
-          if (Usb2HcPpi != NULL) {
-            Usb2HcPpi->ClearRootHubPortFeature (
-              PeiServices,
-              Usb2HcPpi,
-              (UINT8) Index,
-              EfiUsbPortResetChange
-              );
-          } else {
-            UsbHcPpi->ClearRootHubPortFeature (
-              PeiServices,
-              UsbHcPpi,
-              (UINT8) Index,
-              EfiUsbPortResetChange
-              );
-          }
-        }
-
-        PeiUsbDevice->DeviceSpeed = (UINT8) PeiUsbGetDeviceSpeed (PortStatus.PortStatus);
-        DEBUG ((DEBUG_VERBOSE, "Device Speed =%d\n", PeiUsbDevice->DeviceSpeed));
-
-        if (USB_BIT_IS_SET (PortStatus.PortStatus, USB_PORT_STAT_SUPER_SPEED)) {
-          PeiUsbDevice->MaxPacketSize0 = 512;
-        } else if (USB_BIT_IS_SET (PortStatus.PortStatus, USB_PORT_STAT_HIGH_SPEED)) {
-          PeiUsbDevice->MaxPacketSize0 = 64;
-        } else if (USB_BIT_IS_SET (PortStatus.PortStatus, USB_PORT_STAT_LOW_SPEED)) {
-          PeiUsbDevice->MaxPacketSize0 = 8;
-        } else {
-          PeiUsbDevice->MaxPacketSize0 = 8;
-        }
-
-        //
-        // Configure that Usb Device
-        //
-        Status = PeiConfigureUsbDevice (
-                   PeiServices,
-                   PeiUsbDevice,
-                   Index,
-                   &CurrentAddress
-                   );
-
-        if (EFI_ERROR (Status)) {
-          FreePages (PeiUsbDevice, MemPages);
-          continue;
-        }
-        DEBUG ((DEBUG_VERBOSE, "PeiUsbEnumeration: PeiConfigureUsbDevice Success\n"));
-
-        if (PeiUsbDevice->InterfaceDesc->InterfaceClass == 0x09) {
-          PeiUsbDevice->IsHub = 0x1;
-
-          Status = PeiDoHubConfig (PeiServices, PeiUsbDevice);
-          if (EFI_ERROR (Status)) {
-            FreePages (PeiUsbDevice, MemPages);
-            return Status;
-          }
-
-          Status = PeiHubEnumeration (PeiServices, PeiUsbDevice, &CurrentAddress);
-          if (EFI_ERROR (Status)) {
-            FreePages (PeiUsbDevice, MemPages);
-            return Status;
-          }
-        }
-
-        //
-        // Install UsbIo PPI for the new device only after successful configuration and hub enumeration
-        //
-        Status = PeiServicesInstallPpi (&PeiUsbDevice->UsbIoPpiList);
-        if (EFI_ERROR (Status)) {
-          FreePages (PeiUsbDevice, MemPages);
-          continue;
-        }
-
-        {
-          // Keep the original (first-interface) device pointer stable so that
-          // (a) the loop condition is never evaluated against freed memory, and
-          // (b) every clone is always made from the same source, giving a
-          //     constant DataDelta and avoiding chained-delta fragility.
-          PEI_USB_DEVICE  *BaseDevice    = PeiUsbDevice;
-          PEI_USB_DEVICE  *ClonedDevice;
-          UINTN            NumInterfaces = BaseDevice->ConfigDesc->NumInterfaces;
-          UINTN            IfIdx;
-          UINTN            EpIdx;
-          INTN             DataDelta;
+    }
 
-          for (InterfaceIndex = 1; InterfaceIndex < NumInterfaces; InterfaceIndex++) {
-            //
-            // Clone the base (first-interface) device for each additional interface.
-            //
-            MemPages = sizeof (PEI_USB_DEVICE) / EFI_PAGE_SIZE + 1;
-            Status = PeiServicesAllocatePages (
-                       EfiBootServicesCode,
-                       MemPages,
-                       &AllocateAddress
-                       );
-            if (EFI_ERROR (Status)) {
-              return EFI_OUT_OF_RESOURCES;
-            }
+    if (((PortStatus.PortChangeStatus & USB_PORT_STAT_C_RESET) == 0) ||
+        ((PortStatus.PortStatus & (USB_PORT_STAT_CONNECTION | USB_PORT_STAT_ENABLE)) == 0)) {
+      ResetPending[Index] = TRUE;
+      ResetCount++;
+      continue;
+    }
 
-            CopyMem ((VOID *) (UINTN)AllocateAddress, BaseDevice, sizeof (PEI_USB_DEVICE));
-            ClonedDevice = (PEI_USB_DEVICE *) ((UINTN) AllocateAddress);
-            ClonedDevice->AllocateAddress  = (UINTN) AllocateAddress;
-            ClonedDevice->UsbIoPpiList.Ppi = &ClonedDevice->UsbIoPpi;
+    //
+    // If the port already has reset change flag and is connected and enabled, skip the port reset logic.
+    //
+    ClearRootPortFeature (PeiServices, UsbHcPpi, Usb2HcPpi, Index, EfiUsbPortResetChange);
 
-            // Relocate all ConfigurationData-relative pointers from the base
-            // allocation to the equivalent offset in the new copy.
-            DataDelta = (INTN)ClonedDevice->ConfigurationData -
-                        (INTN)BaseDevice->ConfigurationData;
-            if (ClonedDevice->ConfigDesc != NULL) {
-              ClonedDevice->ConfigDesc = (EFI_USB_CONFIG_DESCRIPTOR *)((UINT8 *)ClonedDevice->ConfigDesc + DataDelta);
-            }
+    Status = PeiUsbConfigureRootPortDevice (PeiServices, UsbHcPpi, Usb2HcPpi, Index, &PortStatus, &CurrentAddress);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
 
-            for (IfIdx = 0; IfIdx < MAX_INTERFACE; IfIdx++) {
-              if (ClonedDevice->InterfaceDescList[IfIdx] != NULL) {
-                ClonedDevice->InterfaceDescList[IfIdx] =
-                  (EFI_USB_INTERFACE_DESCRIPTOR *)((UINT8 *)ClonedDevice->InterfaceDescList[IfIdx] + DataDelta);
-              }
-              for (EpIdx = 0; EpIdx < MAX_ENDPOINT; EpIdx++) {
-                if (ClonedDevice->EndpointDescList[IfIdx][EpIdx] != NULL) {
-                  ClonedDevice->EndpointDescList[IfIdx][EpIdx] =
-                    (EFI_USB_ENDPOINT_DESCRIPTOR *)((UINT8 *)ClonedDevice->EndpointDescList[IfIdx][EpIdx] + DataDelta);
-                }
-              }
-            }
+  if (ResetCount == 0) {
+    return EFI_SUCCESS;
+  }
 
-            ClonedDevice->InterfaceDesc = ClonedDevice->InterfaceDescList[InterfaceIndex];
-            for (EndpointIndex = 0; EndpointIndex < ClonedDevice->InterfaceDesc->NumEndpoints; EndpointIndex++) {
-              ClonedDevice->EndpointDesc[EndpointIndex] = ClonedDevice->EndpointDescList[InterfaceIndex][EndpointIndex];
-            }
+  //
+  // All devices were connected before the scan, so one debounce time covers them all.
+  // Then start the reset of every port so that they run at the same time.
+  //
+  MicroSecondDelay (USB_PORT_CONNECT_DEBOUNCE_STALL);
+  for (Index = 0; Index < NumOfRootPort; Index++) {
+    if (ResetPending[Index]) {
+      Status = SetRootPortFeature (PeiServices, UsbHcPpi, Usb2HcPpi, Index, EfiUsbPortReset);
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "SetRootHubPortFeature EfiUsbPortReset Failed\n"));
+        ResetPending[Index] = FALSE;
+      }
+    }
+  }
 
-            if (ClonedDevice->InterfaceDesc->InterfaceClass == 0x09) {
-              ClonedDevice->IsHub = 0x1;
+  //
+  // Devices are configured one at a time, since a new device answers to the default address.
+  //
+  for (Index = 0; Index < NumOfRootPort; Index++) {
+    if (!ResetPending[Index]) {
+      continue;
+    }
 
-              Status = PeiDoHubConfig (PeiServices, ClonedDevice);
-              if (EFI_ERROR (Status)) {
-                FreePages (ClonedDevice, MemPages);
-                return Status;
-              }
+    Status = FinishRootPortReset (PeiServices, UsbHcPpi, Usb2HcPpi, Index, 0);
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
 
-              Status = PeiHubEnumeration (PeiServices, ClonedDevice, &CurrentAddress);
-              if (EFI_ERROR (Status)) {
-                FreePages (ClonedDevice, MemPages);
-                return Status;
-              }
-            }
+    Status = GetRootPortStatus (PeiServices, UsbHcPpi, Usb2HcPpi, Index, &PortStatus);
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
 
-            //
-            // Install UsbIo PPI for the new device only after successful configuration and hub enumeration
-            //
-            Status = PeiServicesInstallPpi (&ClonedDevice->UsbIoPpiList);
-            if (EFI_ERROR (Status)) {
-              FreePages (ClonedDevice, MemPages);
-              continue;  // safe: BaseDevice is untouched; NumInterfaces is a local
-            }
-          }
-        }
-      } else {
-        //
-        // Disconnect change happen, currently we don't support
-        //
-      }
+    Status = PeiUsbConfigureRootPortDevice (PeiServices, UsbHcPpi, Usb2HcPpi, Index, &PortStatus, &CurrentAddress);
+    if (EFI_ERROR (Status)) {
+      return Status;
     }
   }
 
@@ -1185,216 +1398,17 @@ ResetRootPort (
   )
 {
   EFI_STATUS             Status;
-  UINTN                  Index;
-  EFI_USB_PORT_STATUS    PortStatus;
-
-
-  if (Usb2HcPpi != NULL) {
-    MicroSecondDelay (200 * 1000);
-
-    //
-    // reset root port
-    //
-    Status = Usb2HcPpi->SetRootHubPortFeature (
-               PeiServices,
-               Usb2HcPpi,
-               PortNum,
-               EfiUsbPortReset
-               );
-
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "SetRootHubPortFeature EfiUsbPortReset Failed\n"));
-      return;
-    }
-
-    //
-    // Drive the reset signal for at least 50ms. Check USB 2.0 Spec
-    // section 7.1.7.5 for timing requirements.
-    //
-    MicroSecondDelay (USB_SET_ROOT_PORT_RESET_STALL);
-
-    //
-    // clear reset root port
-    //
-    Status = Usb2HcPpi->ClearRootHubPortFeature (
-               PeiServices,
-               Usb2HcPpi,
-               PortNum,
-               EfiUsbPortReset
-               );
-
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "ClearRootHubPortFeature EfiUsbPortReset Failed\n"));
-      return;
-    }
-
-    MicroSecondDelay (USB_CLR_ROOT_PORT_RESET_STALL);
-
-    //
-    // USB host controller won't clear the RESET bit until
-    // reset is actually finished.
-    //
-    ZeroMem (&PortStatus, sizeof (EFI_USB_PORT_STATUS));
-
-    for (Index = 0; Index < USB_WAIT_PORT_STS_CHANGE_LOOP; Index++) {
-      Status = Usb2HcPpi->GetRootHubPortStatus (
-                 PeiServices,
-                 Usb2HcPpi,
-                 PortNum,
-                 &PortStatus
-                 );
-      if (EFI_ERROR (Status)) {
-        return;
-      }
-
-      if (!USB_BIT_IS_SET (PortStatus.PortStatus, USB_PORT_STAT_RESET)) {
-        break;
-      }
-
-      MicroSecondDelay (USB_WAIT_PORT_STS_CHANGE_STALL);
-    }
-
-    if (Index == USB_WAIT_PORT_STS_CHANGE_LOOP) {
-      DEBUG ((DEBUG_ERROR, "ResetRootPort: reset not finished in time on port %d\n", PortNum));
-      return;
-    }
-
-    Usb2HcPpi->ClearRootHubPortFeature (
-      PeiServices,
-      Usb2HcPpi,
-      PortNum,
-      EfiUsbPortResetChange
-      );
-
-    Usb2HcPpi->ClearRootHubPortFeature (
-      PeiServices,
-      Usb2HcPpi,
-      PortNum,
-      EfiUsbPortConnectChange
-      );
-
-    //
-    // Set port enable
-    //
-    Usb2HcPpi->SetRootHubPortFeature (
-      PeiServices,
-      Usb2HcPpi,
-      PortNum,
-      EfiUsbPortEnable
-      );
-
-    Usb2HcPpi->ClearRootHubPortFeature (
-      PeiServices,
-      Usb2HcPpi,
-      PortNum,
-      EfiUsbPortEnableChange
-      );
-
-    MicroSecondDelay ((RetryIndex + 1) * 50 * 1000);
-  } else {
-    MicroSecondDelay (200 * 1000);
-
-    //
-    // reset root port
-    //
-    Status = UsbHcPpi->SetRootHubPortFeature (
-               PeiServices,
-               UsbHcPpi,
-               PortNum,
-               EfiUsbPortReset
-               );
-
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "SetRootHubPortFeature EfiUsbPortReset Failed\n"));
-      return;
-    }
-
-    //
-    // Drive the reset signal for at least 50ms. Check USB 2.0 Spec
-    // section 7.1.7.5 for timing requirements.
-    //
-    MicroSecondDelay (USB_SET_ROOT_PORT_RESET_STALL);
-
-    //
-    // clear reset root port
-    //
-    Status = UsbHcPpi->ClearRootHubPortFeature (
-               PeiServices,
-               UsbHcPpi,
-               PortNum,
-               EfiUsbPortReset
-               );
-
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "ClearRootHubPortFeature EfiUsbPortReset Failed\n"));
-      return;
-    }
 
-    MicroSecondDelay (USB_CLR_ROOT_PORT_RESET_STALL);
-
-    //
-    // USB host controller won't clear the RESET bit until
-    // reset is actually finished.
-    //
-    ZeroMem (&PortStatus, sizeof (EFI_USB_PORT_STATUS));
-
-    for (Index = 0; Index < USB_WAIT_PORT_STS_CHANGE_LOOP; Index++) {
-      Status = UsbHcPpi->GetRootHubPortStatus (
-                 PeiServices,
-                 UsbHcPpi,
-                 PortNum,
-                 &PortStatus
-                 );
-      if (EFI_ERROR (Status)) {
-        return;
-      }
-
-      if (!USB_BIT_IS_SET (PortStatus.PortStatus, USB_PORT_STAT_RESET)) {
-        break;
-      }
-
-      MicroSecondDelay (USB_WAIT_PORT_STS_CHANGE_STALL);
-    }
-
-    if (Index == USB_WAIT_PORT_STS_CHANGE_LOOP) {
-      DEBUG ((DEBUG_ERROR, "ResetRootPort: reset not finished in time on port %d\n", PortNum));
-      return;
-    }
-
-    UsbHcPpi->ClearRootHubPortFeature (
-      PeiServices,
-      UsbHcPpi,
-      PortNum,
-      EfiUsbPortResetChange
-      );
-
-    UsbHcPpi->ClearRootHubPortFeature (
-      PeiServices,
-      UsbHcPpi,
-      PortNum,
-      EfiUsbPortConnectChange
-      );
-
-    //
-    // Set port enable
-    //
-    UsbHcPpi->SetRootHubPortFeature (
-      PeiServices,
-      UsbHcPpi,
-      PortNum,
-      EfiUsbPortEnable
-      );
-
-    UsbHcPpi->ClearRootHubPortFeature (
-      PeiServices,
-      UsbHcPpi,
-      PortNum,
-      EfiUsbPortEnableChange
-      );
-
-    MicroSecondDelay ((RetryIndex + 1) * 50 * 1000);
+  //
+  // reset root port
+  //
+  Status = SetRootPortFeature (PeiServices, UsbHcPpi, Usb2HcPpi, PortNum, EfiUsbPortReset);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "SetRootHubPortFeature EfiUsbPortReset Failed\n"));
+    return;
   }
-  return;
+
+  FinishRootPortReset (PeiServices, UsbHcPpi, Usb2HcPpi, PortNum, RetryIndex);
 }
 
 /**
@@ -70,20 +70,23 @@ struct _PEI_USB_DEVICE {
 #define USB_BUS_1_MILLISECOND       1000
 
 //
-// Wait for port reset, refers to specification
-// [USB20-7.1.7.5, it says 10ms for hub and 50ms for
-// root hub]
+// Wait for a new connection to be stable before resetting the port,
+// refers to specification [USB20-7.1.7.3, TATTDB is 100ms]
 //
-// According to USB2.0, Chapter 11.5.1.5 Resetting,
-// the worst case for TDRST is 20ms
+#define USB_PORT_CONNECT_DEBOUNCE_STALL (100 * USB_BUS_1_MILLISECOND)
+
+//
+// Drive root hub port reset, refers to specification
+// [USB20-7.1.7.5, it says 50ms for root hub]
+// Hubs time the reset of their ports themselves.
 //
-#define USB_SET_PORT_RESET_STALL        (20 * USB_BUS_1_MILLISECOND)
 #define USB_SET_ROOT_PORT_RESET_STALL   (50 * USB_BUS_1_MILLISECOND)
 
 //
-// Wait for clear roothub port reset, set by experience
+// Wait after port reset before accessing the device, refers to
+// specification [USB20-7.1.7.5, TRSTRCY is 10ms]
 //
-#define USB_CLR_ROOT_PORT_RESET_STALL   (20 * USB_BUS_1_MILLISECOND)
+#define USB_PORT_RESET_RECOVERY_STALL   (10 * USB_BUS_1_MILLISECOND)
 
 //
 // Wait for port statue reg change, set by experience
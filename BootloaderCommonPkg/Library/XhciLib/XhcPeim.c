@@ -1521,10 +1521,10 @@ XhcPeiSetRootHubPortFeature (
       // 1) Write the PORTSC register with the Port Reset (PR) bit set to '1'.
       // 2) Wait for a successful Port Status Change Event for the port, where the Port Reset Change (PRC)
       //    bit in the PORTSC field is set to '1'.
+      // The caller polls the port status for step 2, so that several ports can be reset at the same time.
       //
       State |= XHC_PORTSC_RESET;
       XhcPeiWriteOpReg (Xhc, Offset, State);
-      XhcPeiWaitOpRegBit(Xhc, Offset, XHC_PORTSC_PRC, TRUE, XHC_GENERIC_TIMEOUT);
       break;
 
     case EfiUsbPortPower:
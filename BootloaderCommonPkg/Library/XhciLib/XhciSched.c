@@ -389,7 +389,11 @@ XhcPeiCreateTransferTrb (
         TrbStart->TrbNormal.TDSize    = 0;
         TrbStart->TrbNormal.IntTarget = 0;
         TrbStart->TrbNormal.ISP       = 1;
-        TrbStart->TrbNormal.IOC       = 1;
+        //
+        // Only the last TRB reports its completion, so that a large transfer posts
+        // one event instead of one per 64KB. Short packets are still reported.
+        //
+        TrbStart->TrbNormal.IOC       = ((TotalLen + Len) >= Urb->DataLen) ? 1 : 0;
         TrbStart->TrbNormal.Type      = TRB_TYPE_NORMAL;
         //
         // Update the cycle bit
@@ -583,21 +587,9 @@ XhcPeiIsTransferRingTrb (
   IN URB            *Urb
   )
 {
-  TRB_TEMPLATE  *CheckedTrb;
-  UINTN         Index;
-
-  CheckedTrb = Urb->Ring->RingSeg0;
-
   ASSERT (Urb->Ring->TrbNumber == CMD_RING_TRB_NUMBER || Urb->Ring->TrbNumber == TR_RING_TRB_NUMBER);
 
-  for (Index = 0; Index < Urb->Ring->TrbNumber; Index++) {
-    if (Trb == CheckedTrb) {
-      return TRUE;
-    }
-    CheckedTrb++;
-  }
-
-  return FALSE;
+  return (BOOLEAN) ((Trb >= Urb->Ring->RingSeg0) && (Trb < Urb->Ring->RingSeg0 + Urb->Ring->TrbNumber));
 }
 
 /**
@@ -626,6 +618,7 @@ XhcPeiCheckUrbResult (
   UINT32                    High;
   UINT32                    Low;
   EFI_PHYSICAL_ADDRESS      PhyAddr;
+  UINT64                    TrbBuffer;
 
   ASSERT ((Xhc != NULL) && (Urb != NULL));
 
@@ -637,15 +630,22 @@ XhcPeiCheckUrbResult (
 
   EvtTrb = NULL;
 
-  if (XhcPeiIsHalt (Xhc) || XhcPeiIsSysError (Xhc)) {
-    Urb->Result |= EFI_USB_ERR_SYSTEM;
-    goto EXIT;
+  //
+  // Look for new events in memory first. Only when there is none, read the
+  // status register to make sure the host controller is still running.
+  //
+  XhcPeiSyncEventRing (Xhc, &Xhc->EventRing);
+  if (Xhc->EventRing.EventRingDequeue == Xhc->EventRing.EventRingEnqueue) {
+    if ((XhcPeiReadOpReg (Xhc, XHC_USBSTS_OFFSET) & (XHC_USBSTS_HALT | XHC_USBSTS_HSE)) != 0) {
+      Urb->Result |= EFI_USB_ERR_SYSTEM;
+    }
+    return Urb->Finished;
   }
 
   //
-  // Traverse the event ring to find out all new events from the previous check.
+  // Handle all new events from the previous check in one batch, and advance the
+  // event ring dequeue pointer once for all of them.
   //
-  XhcPeiSyncEventRing (Xhc, &Xhc->EventRing);
   for (Index = 0; Index < Xhc->EventRing.TrbNumber; Index++) {
     Status = XhcPeiCheckNewEvent (Xhc, &Xhc->EventRing, ((TRB_TEMPLATE **) &EvtTrb));
     if (Status == EFI_NOT_READY) {
@@ -712,9 +712,16 @@ XhcPeiCheckUrbResult (
         }
 
         TRBType = (UINT8) (TRBPtr->Type);
-        if ((TRBType == TRB_TYPE_DATA_STAGE) ||
-            (TRBType == TRB_TYPE_NORMAL) ||
-            (TRBType == TRB_TYPE_ISOCH)) {
+        if (TRBType == TRB_TYPE_NORMAL) {
+          //
+          // Earlier TRBs of the transfer may not report completion. All the data
+          // before the reported TRB is transferred, so count from its buffer offset.
+          //
+          TrbBuffer = ((TRANSFER_TRB_NORMAL*)TRBPtr)->TRBPtrLo | LShiftU64 ((UINT64) ((TRANSFER_TRB_NORMAL*)TRBPtr)->TRBPtrHi, 32);
+          CheckedUrb->Completed = (UINTN) (TrbBuffer - (UINTN) CheckedUrb->DataPhy) +
+                                  ((TRANSFER_TRB_NORMAL*)TRBPtr)->Length - EvtTrb->Length;
+        } else if ((TRBType == TRB_TYPE_DATA_STAGE) ||
+                   (TRBType == TRB_TYPE_ISOCH)) {
           CheckedUrb->Completed += (((TRANSFER_TRB_NORMAL*)TRBPtr)->Length - EvtTrb->Length);
         }
 
@@ -728,9 +735,10 @@ XhcPeiCheckUrbResult (
     }
 
     //
-    // Only check first and end Trb event address
+    // Only check first and end Trb event address. A first TRB without IOC
+    // never reports, so the end event alone finishes the transfer.
     //
-    if (TRBPtr == CheckedUrb->TrbStart) {
+    if ((TRBPtr == CheckedUrb->TrbStart) || (((TRANSFER_TRB_NORMAL *) CheckedUrb->TrbStart)->IOC == 0)) {
       CheckedUrb->StartDone = TRUE;
     }
 
@@ -818,13 +826,16 @@ XhcPeiExecTransfer (
     EndTimeStamp = ReadTimeStamp() + MicroSecondToTimeStampTick (Timeout * XHC_1_MILLISECOND);
   }
 
+  //
+  // Checking for new events only reads memory, so poll without a fixed delay.
+  //
   Finished = FALSE;
   while (ReadTimeStamp() < EndTimeStamp) {
     Finished = XhcPeiCheckUrbResult (Xhc, Urb);
     if (Finished) {
       break;
     }
-    MicroSecondDelay (XHC_1_MICROSECOND);
+    CpuPause ();
   }
 
   if (!Finished) {
@@ -9,6 +9,7 @@
 #define _MP_INIT_LIB_H_
 
 #include <Guid/MpCpuTaskInfoHob.h>
+#include <Library/CpuTaskGroupLib.h>
 
 #define SMM_BASE_MIN_SIZE          0x10000
 #define SMM_BASE_GAP               0x2000
@@ -94,6 +95,50 @@ MpRunTask (
   );
 
 
+/**
+  Run a group of tasks on the BSP and all ready APs.
+
+  The APs only take part while MP is in the EnumMpInitRun phase, otherwise
+  all tasks run on the BSP. See CpuTaskGroupRun () for details.
+
+  @param[in]  TaskCount   Number of tasks to run.
+  @param[in]  TaskFunc    Function to run for each task index.
+  @param[in]  Context     Context passed to every TaskFunc call.
+
+  @retval EFI_INVALID_PARAMETER   TaskFunc is NULL.
+  @retval EFI_SUCCESS             All tasks completed.
+
+**/
+EFI_STATUS
+EFIAPI
+MpRunTaskGroup (
+  IN  UINT32               TaskCount,
+  IN  CPU_GROUP_TASK_FUNC  TaskFunc,
+  IN  VOID                *Context
+  );
+
+
+/**
+  Fill a large buffer with a byte value using the BSP and all ready APs.
+
+  The APs only take part while MP is in the EnumMpInitRun phase. See CpuTaskGroupSetMem () for details.
+
+  @param[out] Buffer      Buffer to fill.
+  @param[in]  Length      Number of bytes to fill.
+  @param[in]  Value       Value to fill the buffer with.
+
+  @retval     Buffer
+
+**/
+VOID *
+EFIAPI
+MpSetMem (
+  OUT VOID                *Buffer,
+  IN  UINTN                Length,
+  IN  UINT8                Value
+  );
+
+
 /**
   Dump MP task state
 
@@ -1,6 +1,6 @@
 /** @file
 
-  Copyright (c) 2019 - 2023, Intel Corporation. All rights reserved.<BR>
+  Copyright (c) 2019 - 2026, Intel Corporation. All rights reserved.<BR>
   SPDX-License-Identifier: BSD-2-Clause-Patent
 
 **/
@@ -227,7 +227,6 @@ UpdateFpdtS3Table (
   DEBUG ((DEBUG_VERBOSE, "FPDT: S3Resume->ResumeCount   = %d\n",  S3Resume->ResumeCount));
   DEBUG ((DEBUG_VERBOSE, "FPDT: S3Resume->FullResume    = %ld\n", S3Resume->FullResume));
 
-  AcpiPlatformChecksum ((UINT8 *)Fpdt, Fpdt->Header.Length);
   return  EFI_SUCCESS;
 }
 
@@ -315,7 +314,6 @@ UpdateFpdtSblTable (
         SblPerfTable->SblPerfRecord.Stage1Time, SblPerfTable->SblPerfRecord.Stage2Time,
         SblPerfTable->SblPerfRecord.OsLoaderTime));
 
-  AcpiPlatformChecksum ((UINT8 *)Fpdt, Fpdt->Header.Length);
   return EFI_SUCCESS;
 }
 
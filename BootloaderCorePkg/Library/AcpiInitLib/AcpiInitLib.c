@@ -1,6 +1,6 @@
 /** @file
 
-  Copyright (c) 2017 - 2023, Intel Corporation. All rights reserved.<BR>
+  Copyright (c) 2017 - 2026, Intel Corporation. All rights reserved.<BR>
   SPDX-License-Identifier: BSD-2-Clause-Patent
 
 **/
@@ -83,6 +83,32 @@ AcpiPlatformChecksum (
   Buffer[ChecksumOffset] = CalculateCheckSum8 (Buffer, Size);
 }
 
+/**
+  This function updates a field in an ACPI table and adjusts the table
+  checksum by the change of the field, without summing the whole table.
+  The field must lie within the table.
+
+  @param[in]  Table           Pointer to ACPI table with a valid checksum
+  @param[in]  Field           Pointer to the field in the table
+  @param[in]  Value           Pointer to the new value of the field
+  @param[in]  Size            Size of the field in bytes
+
+**/
+VOID
+AcpiPatchTableField (
+  IN EFI_ACPI_DESCRIPTION_HEADER  *Table,
+  IN VOID                         *Field,
+  IN CONST VOID                   *Value,
+  IN UINTN                         Size
+  )
+{
+  ASSERT (((UINTN)Field >= (UINTN)Table) && ((UINTN)Field + Size <= (UINTN)Table + Table->Length));
+  ASSERT (((UINT8 *)Field + Size <= &Table->Checksum) || ((UINT8 *)Field > &Table->Checksum));
+
+  Table->Checksum = (UINT8)(Table->Checksum + CalculateSum8 (Field, Size) - CalculateSum8 (Value, Size));
+  CopyMem (Field, Value, Size);
+}
+
 /**
   This function updates GNVS data structure base address dynamically.
 
@@ -190,6 +216,8 @@ AcpiTableUpdate (
   EFI_STATUS                        Status;
   S3_DATA                          *S3Data;
   UINT32                            AcpiMax;
+  UINT32                            Address32;
+  UINT64                            Address64;
 
   if ((AcpiTable == NULL) || (Length < sizeof (EFI_ACPI_DESCRIPTION_HEADER))) {
     return EFI_INVALID_PARAMETER;
@@ -269,9 +297,10 @@ AcpiTableUpdate (
              Rsdt, EFI_ACPI_5_0_FIXED_ACPI_DESCRIPTION_TABLE_SIGNATURE, &EntryIndex);
       if (Facp != NULL) {
         DEBUG ((DEBUG_INFO, "Replaced\n"));
-        Facp->Dsdt  = (UINT32)(UINTN)AcpiHdr;
-        Facp->XDsdt = (UINT64)(UINTN)AcpiHdr;
-        AcpiPlatformChecksum ((UINT8 *)Facp, Facp->Header.Length);
+        Address32 = (UINT32)(UINTN)AcpiHdr;
+        Address64 = (UINT64)(UINTN)AcpiHdr;
+        AcpiPatchTableField (&Facp->Header, &Facp->Dsdt, &Address32, sizeof (Address32));
+        AcpiPatchTableField (&Facp->Header, &Facp->XDsdt, &Address64, sizeof (Address64));
         UpdateAcpiGnvs (AcpiHdr, PcdGet32 (PcdAcpiGnvsAddress));
       } else {
         Status = EFI_ABORTED;
@@ -532,6 +561,8 @@ AcpiInit (
   UINT32                    EndIdx;
   BOOLEAN                   Loop;
   UINT64                    Signature;
+  UINT32                    Address32;
+  UINT64                    Address64;
   CONST EFI_ACPI_COMMON_HEADER  **AcpiTblTmpl;
 
   Facs = NULL;
@@ -676,12 +707,10 @@ AcpiInit (
         }
         ASSERT (XsdtIndex < PcdGet32 (PcdAcpiTablesMaxEntry));
 
-        if (Current != (UINT8 *)Facp) {
-          AcpiPlatformChecksum (
-            Current,
-            ((EFI_ACPI_COMMON_HEADER *)Current)->Length
-            );
-        }
+        AcpiPlatformChecksum (
+          Current,
+          ((EFI_ACPI_COMMON_HEADER *)Current)->Length
+          );
 
         Current += ((EFI_ACPI_COMMON_HEADER *)Current)->Length;
       } else {
@@ -702,12 +731,17 @@ AcpiInit (
     return EFI_NOT_FOUND;
   }
 
-  Facp->FirmwareCtrl  = (UINT32)(UINTN)Facs;
-  Facp->XFirmwareCtrl = (UINT64)(UINTN)Facs;
-  Facp->Dsdt  = (UINT32)(UINTN)Dsdt;
-  Facp->XDsdt = (UINT64)(UINTN)Dsdt;
-
-  AcpiPlatformChecksum ((UINT8 *)Facp, Facp->Header.Length);
+  //
+  // FACP was checksummed when it was published, only adjust for the table links
+  //
+  Address32 = (UINT32)(UINTN)Facs;
+  Address64 = (UINT64)(UINTN)Facs;
+  AcpiPatchTableField (&Facp->Header, &Facp->FirmwareCtrl, &Address32, sizeof (Address32));
+  AcpiPatchTableField (&Facp->Header, &Facp->XFirmwareCtrl, &Address64, sizeof (Address64));
+  Address32 = (UINT32)(UINTN)Dsdt;
+  Address64 = (UINT64)(UINTN)Dsdt;
+  AcpiPatchTableField (&Facp->Header, &Facp->Dsdt, &Address32, sizeof (Address32));
+  AcpiPatchTableField (&Facp->Header, &Facp->XDsdt, &Address64, sizeof (Address64));
 
   Rsdt->Length = sizeof (EFI_ACPI_DESCRIPTION_HEADER) + XsdtIndex * sizeof (UINT32);
   AcpiPlatformChecksum ((UINT8 *)Rsdt, Rsdt->Length);
@@ -83,4 +83,23 @@ AcpiPlatformChecksum (
   IN UINTN      Size
   );
 
+/**
+  This function updates a field in an ACPI table and adjusts the table
+  checksum by the change of the field, without summing the whole table.
+  The field must lie within the table.
+
+  @param[in]  Table           Pointer to ACPI table with a valid checksum
+  @param[in]  Field           Pointer to the field in the table
+  @param[in]  Value           Pointer to the new value of the field
+  @param[in]  Size            Size of the field in bytes
+
+**/
+VOID
+AcpiPatchTableField (
+  IN EFI_ACPI_DESCRIPTION_HEADER  *Table,
+  IN VOID                         *Field,
+  IN CONST VOID                   *Value,
+  IN UINTN                         Size
+  );
+
 #endif
@@ -12,6 +12,7 @@
 #include <Library/MemoryAllocationLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
+#include <Library/SynchronizationLib.h>
 #include <BootloaderCoreGlobal.h>
 
 #define   POOL_MIN_ALIGNMENT    0x10
@@ -19,10 +20,18 @@
 /**
   Update the Memory pool top address.
 
-  @param [in] Top Top address to update.
+  The top is moved with an atomic compare-exchange so that an AP task running
+  in parallel with the BSP can allocate from the same pool.
+
+  @param [in] CurrTop  Top address the new top was computed from.
+  @param [in] Top      Top address to update.
+
+  @retval TRUE         The pool top was updated.
+  @retval FALSE        The pool top changed in the meantime, retry the allocation.
  **/
-VOID
+BOOLEAN
 InternalUpdateMemPoolTop (
+  IN UINT32  CurrTop,
   IN UINT32  Top
   )
 {
@@ -30,13 +39,17 @@ InternalUpdateMemPoolTop (
   UINT32               PoolUsed;
 
   LdrGlobal = GetLoaderGlobalDataPointer();
+  ASSERT (Top >= LdrGlobal->MemPoolCurrBottom);
+  if (InterlockedCompareExchange32 (&LdrGlobal->MemPoolCurrTop, CurrTop, Top) != CurrTop) {
+    return FALSE;
+  }
+
   PoolUsed = (LdrGlobal->MemPoolEnd - Top) +
               (LdrGlobal->MemPoolCurrBottom - LdrGlobal->MemPoolStart);
   if (LdrGlobal->MemPoolMaxUsed < PoolUsed) {
     LdrGlobal->MemPoolMaxUsed = PoolUsed;
   }
-  ASSERT (Top >= LdrGlobal->MemPoolCurrBottom);
-  LdrGlobal->MemPoolCurrTop = Top;
+  return TRUE;
 }
 
 /**
@@ -82,13 +95,15 @@ AllocatePool (
   )
 {
   LOADER_GLOBAL_DATA  *LdrGlobal;
+  UINT32               CurrTop;
   UINT32               Top;
 
   LdrGlobal = GetLoaderGlobalDataPointer();
-  Top  = LdrGlobal->MemPoolCurrTop;
-  Top -= (UINT32)AllocationSize;
-  Top  = ALIGN_DOWN (Top, POOL_MIN_ALIGNMENT);
-  InternalUpdateMemPoolTop (Top);
+  do {
+    CurrTop = LdrGlobal->MemPoolCurrTop;
+    Top  = CurrTop - (UINT32)AllocationSize;
+    Top  = ALIGN_DOWN (Top, POOL_MIN_ALIGNMENT);
+  } while (!InternalUpdateMemPoolTop (CurrTop, Top));
   return (VOID *)(UINTN)Top;
 }
 
@@ -140,6 +155,7 @@ AllocatePages (
   )
 {
   LOADER_GLOBAL_DATA  *LdrGlobal;
+  UINT32               CurrTop;
   UINT32               Top;
 
   if (Pages == 0) {
@@ -147,10 +163,11 @@ AllocatePages (
   }
 
   LdrGlobal = GetLoaderGlobalDataPointer();
-  Top  = LdrGlobal->MemPoolCurrTop;
-  Top  = ALIGN_DOWN (Top, EFI_PAGE_SIZE);
-  Top -= (UINT32)(Pages * EFI_PAGE_SIZE);
-  InternalUpdateMemPoolTop (Top);
+  do {
+    CurrTop = LdrGlobal->MemPoolCurrTop;
+    Top  = ALIGN_DOWN (CurrTop, EFI_PAGE_SIZE);
+    Top -= (UINT32)(Pages * EFI_PAGE_SIZE);
+  } while (!InternalUpdateMemPoolTop (CurrTop, Top));
   return (VOID *)(UINTN)Top;
 }
 
@@ -180,6 +197,7 @@ AllocateAlignedPages (
   )
 {
   LOADER_GLOBAL_DATA  *LdrGlobal;
+  UINT32               CurrTop;
   UINT32               Top;
 
   if (Pages == 0) {
@@ -187,14 +205,15 @@ AllocateAlignedPages (
   }
 
   LdrGlobal = GetLoaderGlobalDataPointer();
-  Top  = LdrGlobal->MemPoolCurrTop;
-  Top  = ALIGN_DOWN (Top, EFI_PAGE_SIZE);
-  Top -= (UINT32)(Pages * EFI_PAGE_SIZE);
-  if (Alignment > EFI_PAGE_SIZE) {
-    Top  = ALIGN_DOWN (Top, Alignment);
-  }
-  Top  = ALIGN_DOWN (Top, EFI_PAGE_SIZE);
-  InternalUpdateMemPoolTop (Top);
+  do {
+    CurrTop = LdrGlobal->MemPoolCurrTop;
+    Top  = ALIGN_DOWN (CurrTop, EFI_PAGE_SIZE);
+    Top -= (UINT32)(Pages * EFI_PAGE_SIZE);
+    if (Alignment > EFI_PAGE_SIZE) {
+      Top  = ALIGN_DOWN (Top, Alignment);
+    }
+    Top  = ALIGN_DOWN (Top, EFI_PAGE_SIZE);
+  } while (!InternalUpdateMemPoolTop (CurrTop, Top));
   return (VOID *)(UINTN)Top;
 }
 
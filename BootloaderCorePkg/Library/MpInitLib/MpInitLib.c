@@ -15,6 +15,8 @@ STATIC UINT8                             *mBackupBuffer;
 STATIC UINT32                             mMpInitPhase = EnumMpInitNull;
 STATIC SMMBASE_INFO                      *mSmmBaseInfo;
 STATIC MTRR_SETTINGS                      mMtrrTable;
+STATIC UINT32                             mTopologyCpuCount;
+STATIC UINT64                             mApWakeupTimeStamp;
 extern UINT8                             *mDefaultSmiHandlerStart;
 extern UINT8                             *mDefaultSmiHandlerRet;
 extern UINT8                             *mDefaultSmiHandlerEnd;
@@ -283,6 +285,65 @@ CpuInit (
 }
 
 
+/**
+  Get the number of logical processors in the system from CPUID topology.
+
+  Leaf 0x1F is preferred over leaf 0x0B. These leaves only describe one
+  package, so the count is multiplied by PcdCpuPackageCount. The count
+  reflects the packages as shipped, so it can be larger than the number
+  of enabled threads.
+
+  @retval  0              The topology leaves are not supported, or the
+                          package count is unknown.
+  @retval  Others         Number of logical processors in the system.
+
+**/
+STATIC
+UINT32
+GetTopologyCpuCount (
+  VOID
+  )
+{
+  STATIC CONST UINT32          TopologyLeaf[] = { CPUID_V2_EXTENDED_TOPOLOGY, CPUID_EXTENDED_TOPOLOGY };
+  UINT32                       MaxLeaf;
+  UINT32                       Leaf;
+  UINT32                       Index;
+  UINT32                       SubLeaf;
+  UINT32                       Count;
+  CPUID_EXTENDED_TOPOLOGY_EBX  Ebx;
+  CPUID_EXTENDED_TOPOLOGY_ECX  Ecx;
+
+  if (FixedPcdGet32 (PcdCpuPackageCount) == 0) {
+    return 0;
+  }
+
+  AsmCpuid (CPUID_SIGNATURE, &MaxLeaf, NULL, NULL, NULL);
+  for (Index = 0; Index < ARRAY_SIZE (TopologyLeaf); Index++) {
+    Leaf = TopologyLeaf[Index];
+    if (Leaf > MaxLeaf) {
+      continue;
+    }
+    AsmCpuidEx (Leaf, 0, NULL, &Ebx.Uint32, NULL, NULL);
+    if (Ebx.Bits.LogicalProcessors == 0) {
+      continue;
+    }
+
+    // The last valid level covers the whole package
+    Count = 0;
+    for (SubLeaf = 0; SubLeaf < 8; SubLeaf++) {
+      AsmCpuidEx (Leaf, SubLeaf, NULL, &Ebx.Uint32, &Ecx.Uint32, NULL);
+      if (Ecx.Bits.LevelType == CPUID_EXTENDED_TOPOLOGY_LEVEL_TYPE_INVALID) {
+        break;
+      }
+      Count = Ebx.Bits.LogicalProcessors;
+    }
+    return Count * FixedPcdGet32 (PcdCpuPackageCount);
+  }
+
+  return 0;
+}
+
+
 /**
   AP initialization routine.
 
@@ -364,6 +425,7 @@ MpInit (
   UINT8                    *ApBuffer;
   EFI_STATUS                Status;
   UINT32                    TimeOutCounter;
+  BOOLEAN                   WaitDone;
   AP_DATA_STRUCT           *ApDataPtr;
   volatile UINT32          *ApCounter;
   UINT32                    CpuCount;
@@ -479,7 +541,9 @@ MpInit (
       // It includes a 200us delay for AP's check-in
       // If it is not long enough, extra delay can be added after this call
       //
+      mTopologyCpuCount  = GetTopologyCpuCount ();
       SendInitSipiSipiAllExcludingSelf ((UINT32)(UINTN)ApBuffer);
+      mApWakeupTimeStamp = ReadTimeStamp ();
 
       CpuInit (0);
 
@@ -497,28 +561,35 @@ MpInit (
       // (ApDataPtr->ApCounter) have completed wakeup
       // (mMpDataStruct.ApDoneCounter), or the timeout is reached
       // (AP_TASK_TIMEOUT_UNIT * AP_TASK_TIMEOUT_CNT). Whichever occurs
-      // first. This assumes that the number of running APs is never zero
-      // unless all APs have completed wakeup. This is not always the case
-      // with high core counts and tight timings, so a fixed delay here can
-      // help ensure all APs have started before this check.
-
-      if (FixedPcdGet32 (PcdCpuApInitWaitInMicroSeconds)) {
-        MicroSecondDelay (FixedPcdGet32 (PcdCpuApInitWaitInMicroSeconds));
-      }
+      // first. With high core counts and tight timings the number of
+      // running APs can be zero before all APs have started. So the count
+      // is only trusted once it reaches the CPUID topology thread count of
+      // all PcdCpuPackageCount packages, or PcdCpuApInitWaitInMicroSeconds
+      // has passed since the SIPI. The topology count is an upper bound
+      // only, as some threads may be disabled. Without a package count
+      // the full delay is always used.
 
       ApDataPtr = (AP_DATA_STRUCT *) (ApBuffer + mStubCodeSize);
       ApCounter = (volatile UINT32 *)&ApDataPtr->ApCounter;
       TimeOutCounter = 0;
       while (TimeOutCounter < AP_TASK_TIMEOUT_CNT) {
+        WaitDone = (TimeStampTickToMicroSecond (ReadTimeStamp () - mApWakeupTimeStamp) >=
+                    FixedPcdGet32 (PcdCpuApInitWaitInMicroSeconds));
         if (mMpDataStruct.ApDoneCounter == *ApCounter) {
-          break;
+          if (WaitDone || ((mTopologyCpuCount != 0) && (*ApCounter + 1 >= mTopologyCpuCount))) {
+            break;
+          }
         }
         MicroSecondDelay (AP_TASK_TIMEOUT_UNIT);
-        TimeOutCounter++ ;
+        if (WaitDone) {
+          TimeOutCounter++ ;
+        }
       }
+      AddMeasurePoint (0x3070);
 
       CpuCount = (*ApCounter) + 1;
-      DEBUG ((DEBUG_INFO, "Detected %d CPU threads\n", CpuCount));
+      DEBUG ((DEBUG_INFO, "Detected %d CPU threads (%d in topology) in %ld us\n", CpuCount, mTopologyCpuCount,
+              TimeStampTickToMicroSecond (ReadTimeStamp () - mApWakeupTimeStamp)));
       if (TimeOutCounter == AP_TASK_TIMEOUT_CNT) {
         DEBUG ((DEBUG_INFO, "MPINIT timeout with %d APs completed.\n", mMpDataStruct.ApDoneCounter));
       }
@@ -658,6 +729,58 @@ MpRunTask (
 }
 
 
+/**
+  Run a group of tasks on the BSP and all ready APs.
+
+  The APs only take part while MP is in the EnumMpInitRun phase, otherwise
+  all tasks run on the BSP. See CpuTaskGroupRun () for details.
+
+  @param[in]  TaskCount   Number of tasks to run.
+  @param[in]  TaskFunc    Function to run for each task index.
+  @param[in]  Context     Context passed to every TaskFunc call.
+
+  @retval EFI_INVALID_PARAMETER   TaskFunc is NULL.
+  @retval EFI_SUCCESS             All tasks completed.
+
+**/
+EFI_STATUS
+EFIAPI
+MpRunTaskGroup (
+  IN  UINT32               TaskCount,
+  IN  CPU_GROUP_TASK_FUNC  TaskFunc,
+  IN  VOID                *Context
+  )
+{
+  return CpuTaskGroupRun ((mMpInitPhase == EnumMpInitRun) ? (SYS_CPU_TASK *)&mSysCpuTask : NULL,
+                          TaskCount, TaskFunc, Context);
+}
+
+
+/**
+  Fill a large buffer with a byte value using the BSP and all ready APs.
+
+  The APs only take part while MP is in the EnumMpInitRun phase. See CpuTaskGroupSetMem () for details.
+
+  @param[out] Buffer      Buffer to fill.
+  @param[in]  Length      Number of bytes to fill.
+  @param[in]  Value       Value to fill the buffer with.
+
+  @retval     Buffer
+
+**/
+VOID *
+EFIAPI
+MpSetMem (
+  OUT VOID                *Buffer,
+  IN  UINTN                Length,
+  IN  UINT8                Value
+  )
+{
+  return CpuTaskGroupSetMem ((mMpInitPhase == EnumMpInitRun) ? (SYS_CPU_TASK *)&mSysCpuTask : NULL,
+                             Buffer, Length, Value);
+}
+
+
 /**
   Dump MP task running state
 
@@ -24,7 +24,10 @@
 #include <Library/ExtraBaseLib.h>
 #include <Library/BootloaderCoreLib.h>
 #include <Library/S3SaveRestoreLib.h>
+#include <Library/TimeStampLib.h>
+#include <Library/LoaderPerformanceLib.h>
 #include <Register/Intel/ArchitecturalMsr.h>
+#include <Register/Intel/Cpuid.h>
 #include <Guid/SmmS3CommunicationInfoGuid.h>
 
 #define   AP_BUFFER_ADDRESS        0x38000
@@ -1,6 +1,6 @@
 /** @file
 
-  Copyright (c) 2019 - 2021, Intel Corporation. All rights reserved.<BR>
+  Copyright (c) 2019 - 2026, Intel Corporation. All rights reserved.<BR>
   SPDX-License-Identifier: BSD-2-Clause-Patent
 
 **/
@@ -320,8 +320,7 @@ RestoreS3RegInfo (
 {
   UINT8     Index;
   UINT32    Data32;
-  UINT8     Type;
-  UINT8     Width;
+  REG_INFO  *RegInfo;
   EFI_STATUS Status;
 
   if (S3SaveReg == NULL || S3SaveReg->S3SaveHdr.Id != S3_SAVE_REG_COMM_ID) {
@@ -329,20 +328,24 @@ RestoreS3RegInfo (
   }
 
   for (Index = 0; Index < S3SaveReg->S3SaveHdr.Count; Index++) {
-    if (S3SaveReg->RegInfo[Index].Addr != 0x00) {
-      Type = S3SaveReg->RegInfo[Index].Type;
-      Width = S3SaveReg->RegInfo[Index].Width;
+    RegInfo = &S3SaveReg->RegInfo[Index];
+    if (RegInfo->Addr == 0x00) {
+      continue;
+    }
 
-      Status = RegWrite (Type, Width, S3SaveReg->RegInfo[Index].Addr, S3SaveReg->RegInfo[Index].Val);
-      if (EFI_ERROR (Status)) {
-        return Status;
-      }
-      Status = RegRead (Type, Width, S3SaveReg->RegInfo[Index].Addr, &Data32);
-      if (EFI_ERROR (Status)) {
-        return Status;
-      }
-      DEBUG ((DEBUG_INFO, "Value after restore reg @ 0x%08X=0x%08X\n", S3SaveReg->RegInfo[Index].Addr, Data32));
+    Status = RegWrite (RegInfo->Type, RegInfo->Width, RegInfo->Addr, RegInfo->Val);
+    if (EFI_ERROR (Status)) {
+      return Status;
     }
+
+    //
+    // Read back for the debug log only, it is not needed to restore the register
+    //
+    DEBUG_CODE_BEGIN ();
+    Data32 = 0;
+    RegRead (RegInfo->Type, RegInfo->Width, RegInfo->Addr, &Data32);
+    DEBUG ((DEBUG_INFO, "Value after restore reg @ 0x%08X=0x%08X\n", RegInfo->Addr, Data32));
+    DEBUG_CODE_END ();
   }
 
   return EFI_SUCCESS;
@@ -332,6 +332,7 @@ NormalBootPath (
   ASSERT_EFI_ERROR (Status);
 
   BoardInit (EndOfStages);
+  AddMeasurePoint (0x3190);
 
   PayloadId = GetPayloadId ();
   if (PayloadId == 0) {
@@ -432,6 +433,7 @@ S3ResumePath (
 
   // Call the board notification
   BoardInit (EndOfStages);
+  AddMeasurePoint (0x3190);
 
   // Call board and FSP Notify ReadyToBoot
   BoardNotifyPhase (ReadyToBoot);
@@ -490,6 +492,7 @@ SecStartup (
   VOID                           *SmbiosEntry;
   BOOLEAN                         SplashPostPci;
   UINT8                           SmmRebaseMode;
+  BOOLEAN                         S3Resume;
 
   // Initialize HOB
   LdrGlobal = (LOADER_GLOBAL_DATA *)GetLoaderGlobalDataPointer();
@@ -514,6 +517,7 @@ SecStartup (
   InitializeService ();
 
   BootMode = GetBootMode ();
+  S3Resume = ACPI_ENABLED () && (BootMode == BOOT_ON_S3_RESUME);
 
   // Update Patchable PCD in case Stage2 is loaded into high mem
   Stage2Param = (STAGE2_PARAM *)Params;
@@ -574,9 +578,9 @@ SecStartup (
   // Create base HOB
   BuildBaseInfoHob (Stage2Param);
 
-  // Display splash
+  // Display splash, the OS restores its own display on S3 resume
   SplashPostPci = FALSE;
-  if (FixedPcdGetBool (PcdSplashEnabled)) {
+  if (FixedPcdGetBool (PcdSplashEnabled) && !S3Resume) {
     Status = DisplaySplash ();
     AddMeasurePoint (0x3050);
     if (Status == EFI_NOT_FOUND) {
@@ -655,7 +659,7 @@ SecStartup (
   AddMeasurePoint (0x3090);
 
   // Make sure to get Saved S3 info before Payload SwSmi call that sets SMRR
-  if (ACPI_ENABLED () && (BootMode == BOOT_ON_S3_RESUME)) {
+  if (S3Resume) {
     S3Data = (S3_DATA *)LdrGlobal->S3DataPtr;
     S3Data->FacsAddress = GetFacsAddressForS3();
     S3Data->AcpiBase = (UINT32)GetAcpiBaseForS3();
@@ -693,6 +697,9 @@ SecStartup (
     }
   }
 
+  // Bring up the primary boot device in parallel with the rest of Stage2
+  StartEarlyBootDeviceInit ();
+
   // ACPI Initialization
   if (ACPI_ENABLED ()) {
     AcpiGnvs = 0;
@@ -736,6 +743,8 @@ SecStartup (
     PlatformService->ResetSystem = ResetSystem;
   }
 
+  WaitEarlyBootDeviceInit ();
+
   BoardInit (PrePayloadLoading);
   AddMeasurePoint (0x30E0);
 
@@ -752,7 +761,7 @@ SecStartup (
   }
 
   // Continue boot flow
-  if (ACPI_ENABLED() && (BootMode == BOOT_ON_S3_RESUME)) {
+  if (S3Resume) {
     S3ResumePath (Stage2Param);
   } else {
     NormalBootPath (Stage2Param);
@@ -40,6 +40,7 @@
 #include <Library/StageLib.h>
 #include <Library/ThunkLib.h>
 #include <Library/LocalApicLib.h>
+#include <Library/TimerLib.h>
 #include <Library/ContainerLib.h>
 #include <Library/TcoTimerLib.h>
 #include <Library/WatchDogTimerLib.h>
@@ -82,6 +83,7 @@
 #include <Library/BuildFdtLib.h>
 #include <Library/PlatformHookLib.h>
 #include <Library/S3SaveRestoreLib.h>
+#include <Library/MmcAccessLib.h>
 
 #define UIMAGE_FIT_MAGIC               (0x56190527)
 
@@ -102,6 +104,17 @@ BuildBaseInfoHob (
   IN  STAGE2_PARAM                   *Stage2Param
   );
 
+/**
+  Build the OS boot option HOB.
+
+  @return                  The OS boot option list in the HOB, or NULL on failure.
+**/
+OS_BOOT_OPTION_LIST *
+EFIAPI
+BuildOsBootOptionHob (
+  VOID
+  );
+
 /**
   Build and update HOBs.
 
@@ -189,4 +202,25 @@ UpdateGraphicsHob (
   VOID
   );
 
+/**
+  Start the primary boot device initialization on an AP.
+
+**/
+VOID
+EFIAPI
+StartEarlyBootDeviceInit (
+  VOID
+  );
+
+/**
+  Wait for the primary boot device initialization started by
+  StartEarlyBootDeviceInit () to complete.
+
+**/
+VOID
+EFIAPI
+WaitEarlyBootDeviceInit (
+  VOID
+  );
+
 #endif
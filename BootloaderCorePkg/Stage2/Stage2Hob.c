@@ -684,6 +684,39 @@ BuildSmmVariableHobs (
   }
 }
 
+/**
+  Build the OS boot option HOB.
+
+  The board hook fills the boot option list only once. If the HOB was already
+  built earlier in Stage2, the existing one is returned.
+
+  @return                  The OS boot option list in the HOB, or NULL on failure.
+**/
+OS_BOOT_OPTION_LIST *
+EFIAPI
+BuildOsBootOptionHob (
+  VOID
+  )
+{
+  OS_BOOT_OPTION_LIST              *OsBootOptionInfo;
+  UINT32                           Length;
+
+  OsBootOptionInfo = (OS_BOOT_OPTION_LIST *)GetGuidHobData (NULL, NULL, &gOsBootOptionGuid);
+  if (OsBootOptionInfo != NULL) {
+    return OsBootOptionInfo;
+  }
+
+  Length = sizeof (OS_BOOT_OPTION_LIST) + sizeof (OS_BOOT_OPTION) * PcdGet32 (PcdOsBootOptionNumber);
+  OsBootOptionInfo = BuildGuidHob (&gOsBootOptionGuid, Length);
+  if (OsBootOptionInfo != NULL) {
+    ZeroMem (OsBootOptionInfo, Length);
+    OsBootOptionInfo->Revision    = 1;
+    OsBootOptionInfo->ResetReason = GetResetReason ();
+    PlatformUpdateHobInfo (&gOsBootOptionGuid, OsBootOptionInfo);
+  }
+
+  return OsBootOptionInfo;
+}
 
 /**
   Build and update HOBs.
@@ -705,7 +738,6 @@ BuildExtraInfoHob (
   UNIVERSAL_PAYLOAD_SERIAL_PORT_INFO *SerialPortInfo;
   SYS_CPU_INFO                     *SysCpuInfo;
   PERFORMANCE_INFO                 *PerformanceInfo;
-  OS_BOOT_OPTION_LIST              *OsBootOptionInfo;
   LOADER_PLATFORM_INFO             *LoaderPlatformInfo;
   LOADER_PLATFORM_DATA             *LoaderPlatformData;
   LOADER_LIBRARY_DATA              *LoaderLibData;
@@ -766,14 +798,7 @@ BuildExtraInfoHob (
   }
 
   // Build OS boot medium info hob
-  Length = sizeof (OS_BOOT_OPTION_LIST) + sizeof (OS_BOOT_OPTION) * PcdGet32 (PcdOsBootOptionNumber);
-  OsBootOptionInfo = BuildGuidHob (&gOsBootOptionGuid, Length);
-  if (OsBootOptionInfo != NULL) {
-    ZeroMem (OsBootOptionInfo, Length);
-    OsBootOptionInfo->Revision    = 1;
-    OsBootOptionInfo->ResetReason = GetResetReason ();
-    PlatformUpdateHobInfo (&gOsBootOptionGuid, OsBootOptionInfo);
-  }
+  BuildOsBootOptionHob ();
 
   // Update seed list hob
   SeedListInfoHob = (SEED_LIST_INFO_HOB *)GetGuidHobData (NULL, NULL, &gSeedListInfoHobGuid);
@@ -7,8 +7,35 @@
 
 #include "Stage2.h"
 
+//
+// CPU used to initialize the primary boot device in the background
+//
+#define EARLY_BOOT_DEVICE_CPU             1
+
+//
+// The 4KB AP stack is too small for the MMC driver, so the task runs on its own stack
+//
+#define EARLY_BOOT_DEVICE_STACK_SIZE      SIZE_16KB
+
+//
+// Time in microseconds to wait for the AP once the BSP needs the device
+//
+#define EARLY_BOOT_DEVICE_TIMEOUT         (2 * 1000 * 1000)
+#define EARLY_BOOT_DEVICE_POLL_UNIT       100
+
+typedef struct {
+  UINT8                     DevType;
+  UINTN                     PciBase;
+  EFI_STATUS                Status;
+  VOID                     *Stack;
+  BASE_LIBRARY_JUMP_BUFFER  JumpBuffer;
+} EARLY_BOOT_DEVICE;
+
 UINT8   mFspPhaseMask;
 
+STATIC EARLY_BOOT_DEVICE   mEarlyBootDevice;
+STATIC BOOLEAN             mEarlyBootDevicePending;
+
 // Create a platform service
 const PLATFORM_SERVICE   mPlatformService = {
   .Header.Signature = PLATFORM_SERVICE_SIGNATURE,
@@ -180,3 +207,175 @@ InitializeService (
   RegisterService ((VOID *)&mPlatformService);
 
 }
+
+/**
+  Initialize the primary boot device.
+
+  @param[in]  Device      The EARLY_BOOT_DEVICE to initialize
+
+  @retval     The status of the device initialization.
+**/
+STATIC
+EFI_STATUS
+InitEarlyBootDevice (
+  IN  EARLY_BOOT_DEVICE   *Device
+  )
+{
+  if (Device->DevType == OsBootDeviceEmmc) {
+    return MmcInitialize (Device->PciBase, DevInitAll);
+  } else {
+    return SdInitialize (Device->PciBase, DevInitAll);
+  }
+}
+
+/**
+  Initialize the primary boot device on the task stack and return to
+  EarlyBootDeviceInitTask () on the AP stack.
+
+  @param[in]  Context1    Pointer to the EARLY_BOOT_DEVICE to initialize
+  @param[in]  Context2    Not used
+
+**/
+STATIC
+VOID
+EFIAPI
+EarlyBootDeviceInitOnStack (
+  IN  VOID                *Context1,
+  IN  VOID                *Context2
+  )
+{
+  EARLY_BOOT_DEVICE      *Device;
+
+  Device = (EARLY_BOOT_DEVICE *)Context1;
+  Device->Status = InitEarlyBootDevice (Device);
+  LongJump (&Device->JumpBuffer, 1);
+}
+
+/**
+  CPU task to initialize the primary boot device.
+
+  @param[in]  Argument    Pointer to the EARLY_BOOT_DEVICE to initialize
+
+  @retval     The status of the device initialization.
+**/
+STATIC
+UINT64
+EFIAPI
+EarlyBootDeviceInitTask (
+  IN  UINT64              Argument
+  )
+{
+  EARLY_BOOT_DEVICE      *Device;
+
+  Device = (EARLY_BOOT_DEVICE *)(UINTN)Argument;
+  if (SetJump (&Device->JumpBuffer) == 0) {
+    SwitchStack (EarlyBootDeviceInitOnStack, Device, NULL,
+                 (UINT8 *)Device->Stack + EARLY_BOOT_DEVICE_STACK_SIZE);
+  }
+
+  return (UINT64)Device->Status;
+}
+
+/**
+  Start the primary boot device initialization on an AP.
+
+  The controller bring-up and card ready polling of the primary boot device
+  then overlaps with the remaining Stage2 work. Only eMMC and SD are handled
+  here since MmcAccessLib keeps its controller state in library data, which
+  is handed over to the payload so that OsLoader finds the device already
+  initialized. Debug messages from the AP are dropped by the debug library.
+
+**/
+VOID
+EFIAPI
+StartEarlyBootDeviceInit (
+  VOID
+  )
+{
+  OS_BOOT_OPTION_LIST    *OsBootOptionList;
+  OS_BOOT_OPTION         *OsBootOption;
+  UINT8                   BootMode;
+  EFI_STATUS              Status;
+
+  if (!FeaturePcdGet (PcdEarlyBootDeviceInitEnabled) || FeaturePcdGet (PcdDmaProtectionEnabled)) {
+    return;
+  }
+
+  BootMode = GetBootMode ();
+  if ((BootMode == BOOT_ON_FLASH_UPDATE) || (BootMode == BOOT_ON_S3_RESUME) || (GetPayloadId () != 0)) {
+    return;
+  }
+
+  // The HOB built here is reused by BuildExtraInfoHob ()
+  OsBootOptionList = BuildOsBootOptionHob ();
+  if (OsBootOptionList == NULL) {
+    return;
+  }
+  if (OsBootOptionList->CurrentBoot >= OsBootOptionList->OsBootOptionCount) {
+    return;
+  }
+
+  OsBootOption = &OsBootOptionList->OsBootOption[OsBootOptionList->CurrentBoot];
+  if ((OsBootOption->DevType != OsBootDeviceEmmc) && (OsBootOption->DevType != OsBootDeviceSd)) {
+    return;
+  }
+
+  mEarlyBootDevice.Stack = AllocatePages (EFI_SIZE_TO_PAGES (EARLY_BOOT_DEVICE_STACK_SIZE));
+  if (mEarlyBootDevice.Stack == NULL) {
+    return;
+  }
+
+  mEarlyBootDevice.DevType = OsBootOption->DevType;
+  mEarlyBootDevice.PciBase = TO_MM_PCI_ADDRESS (GetDeviceAddr (OsBootOption->DevType, OsBootOption->DevInstance));
+  mEarlyBootDevice.Status  = EFI_NOT_READY;
+  Status = MpRunTask (EARLY_BOOT_DEVICE_CPU, EarlyBootDeviceInitTask, (UINT64)(UINTN)&mEarlyBootDevice);
+  if (!EFI_ERROR (Status)) {
+    mEarlyBootDevicePending = TRUE;
+  }
+  DEBUG ((DEBUG_INFO, "Early boot device %d init on CPU %d - %r\n",
+          mEarlyBootDevice.DevType, EARLY_BOOT_DEVICE_CPU, Status));
+}
+
+/**
+  Wait for the primary boot device initialization started by
+  StartEarlyBootDeviceInit () to complete.
+
+  If the AP does not finish in time, it is stopped and the device is
+  initialized on the BSP.
+
+**/
+VOID
+EFIAPI
+WaitEarlyBootDeviceInit (
+  VOID
+  )
+{
+  SYS_CPU_TASK           *SysCpuTask;
+  SYS_CPU_INFO           *SysCpuInfo;
+  volatile UINT8         *State;
+  UINT32                  Timeout;
+
+  if (!mEarlyBootDevicePending) {
+    return;
+  }
+  mEarlyBootDevicePending = FALSE;
+
+  SysCpuTask = MpGetTask ();
+  State      = &SysCpuTask->CpuTask[EARLY_BOOT_DEVICE_CPU].State;
+  for (Timeout = 0; (*State != EnumCpuReady) && (Timeout < EARLY_BOOT_DEVICE_TIMEOUT);
+       Timeout += EARLY_BOOT_DEVICE_POLL_UNIT) {
+    MicroSecondDelay (EARLY_BOOT_DEVICE_POLL_UNIT);
+  }
+
+  if (*State != EnumCpuReady) {
+    //
+    // Put the AP into wait-for-SIPI state before the BSP takes over the controller
+    //
+    SysCpuInfo = MpGetInfo ();
+    SendInitIpi (SysCpuInfo->CpuInfo[EARLY_BOOT_DEVICE_CPU].ApicId);
+    DEBUG ((DEBUG_WARN, "Early boot device init timed out on CPU %d, retry on BSP\n", EARLY_BOOT_DEVICE_CPU));
+    mEarlyBootDevice.Status = InitEarlyBootDevice (&mEarlyBootDevice);
+  }
+
+  DEBUG ((DEBUG_INFO, "Early boot device init done - %r\n", mEarlyBootDevice.Status));
+}
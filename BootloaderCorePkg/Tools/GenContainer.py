@@ -516,13 +516,16 @@ class CONTAINER ():
         offset = self.get_header_size ()
         for component in self.header.comp_entry:
             alignment = (1 << component.alignment) - 1
-            next_offset  = (offset + alignment) & ~alignment
-            if is_mono_signing and  (next_offset - offset >=  sizeof(LZ_HEADER)):
-                offset = next_offset - sizeof(LZ_HEADER)
-            else:
-                offset = next_offset
             if base_offset is None:
-                base_offset = offset
+                # component offsets are relative to the aligned data_offset
+                base_offset = (offset + self.header.alignment - 1) & ~(self.header.alignment - 1)
+                offset = base_offset
+            if is_mono_signing:
+                # monolithic signed components are used in place by the loader,
+                # so align the payload behind the LZ header instead of the header
+                offset = ((offset + sizeof(LZ_HEADER) + alignment) & ~alignment) - sizeof(LZ_HEADER)
+            else:
+                offset = (offset + alignment) & ~alignment
             component.offset = offset - base_offset
             offset += component.size
 
@@ -715,6 +718,9 @@ def gen_layout (comp_list, img_type, auth_type_str, svn, out_file, key_dir, key_
 
         if comp_name == 'INRD':
             align = 0x1000
+        elif (idx & 1) and ((img_type == 'MULTIBOOT' and idx >= 3) or img_type == 'MULTIBOOT_MODULE'):
+            # page align multiboot modules so that they can be used in place
+            align = 0x1000
         else:
             align = 0
         layout += "('%s', '%s', 'Dummy', 'NONE', '', %s, 0, %s),\n" % (comp_name, comp_file, align, com_svn)
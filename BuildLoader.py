@@ -177,6 +177,7 @@ class BaseBoard(object):
         self.ENABLE_CRYPTO_SHA_OPT  = IPP_CRYPTO_OPTIMIZATION_MASK['SHA256_V8']
         self.ENABLE_FWU            = 0
         self.ENABLE_FORCE_BIOS_UPDATE = 0
+        self.ENABLE_EARLY_BOOT_DEVICE_INIT = 0
         self.ENABLE_GRUB_CONFIG    = 0
         self.ENABLE_SMBIOS         = 0
         self.ENABLE_LINUX_PAYLOAD  = 0
@@ -208,6 +209,8 @@ class BaseBoard(object):
         self.CPU_MAX_LOGICAL_PROCESSOR_NUMBER = 16
         self.CPU_SORT_METHOD       = 0
         self.CPU_AP_WAIT_TIME_US   = 0
+        # Number of CPU packages, 0 if unknown
+        self.CPU_PACKAGE_COUNT     = 1
 
         self.ACM_SIZE              = 0
         self.ACM_FIT_VERISON       = 0x100
@@ -310,6 +313,9 @@ class BaseBoard(object):
 
         self.RTCM_RSVD_SIZE        = 0xFF000
 
+        # Boot image cache carved from PLD_RSVD_MEM_SIZE for warm resets, 0 to disable
+        self.BOOT_IMAGE_CACHE_SIZE = 0
+
         for key, value in list(kwargs.items()):
             setattr(self, '%s' % key, value)
 
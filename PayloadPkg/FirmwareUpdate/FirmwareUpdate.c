@@ -1614,6 +1614,8 @@ InitFirmwareUpdate (
   EFI_FW_MGMT_CAP_IMAGE_HEADER  *ImgHdr;
   BOOLEAN                       ContainsRedundant;
   FIRMWARE_UPDATE_POLICY        FwPolicy;
+  UINT8                         PendingCount;
+  UINT8                         UpdatedCount;
 
   ImgHdr = NULL;
   FwUpdStatusOffset = PcdGet32(PcdFwUpdStatusBase);
@@ -1720,6 +1722,17 @@ InitFirmwareUpdate (
     return Status;
   }
 
+  //
+  // Count the components left to update for progress reporting
+  //
+  PendingCount = 0;
+  for (Count = 0; Count < MAX_FW_COMPONENTS; Count ++) {
+    if (FwUpdCompStatus[Count].UpdatePending & (BIT0 | BIT1 | BIT2)) {
+      PendingCount++;
+    }
+  }
+  UpdatedCount = 0;
+
   //
   // Loop through the components to perform update
   //
@@ -1758,6 +1771,9 @@ InitFirmwareUpdate (
             continue;
           }
 
+          UpdatedCount++;
+          ConsolePrint ("Updating component %d of %d: %04X:%04X\n", UpdatedCount, PendingCount,
+                        (UINT32)ImgHdr->UpdateHardwareInstance, (UINT32)RShiftU64 (ImgHdr->UpdateHardwareInstance, 32));
           StatusPayloadUpdate = ApplyFwImage(CapsuleImage, CapsuleSize, ImgHdr, FwPolicy, &ResetRequired);
           if (EFI_ERROR (StatusPayloadUpdate)) {
             DEBUG((DEBUG_ERROR, "ApplyFwImage (%04X:%04X) failed with Status = %r\n",
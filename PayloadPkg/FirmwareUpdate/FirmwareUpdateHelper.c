@@ -29,6 +29,7 @@
 #define MSR_IA32_BIOS_SIGN_ID 0x0000008B
 
 SPI_FLASH_SERVICE   *mFwuSpiService = NULL;
+UINT64              mFwuPartitionStartTick;
 
 /**
   This function initialized boot media.
@@ -427,11 +428,71 @@ GetVersionfromFv (
   return EFI_SUCCESS;
 }
 
+/**
+  Erase, program and verify a run of dirty sectors in a flash window.
+
+  @param[in] Address          The boot media address of the run.
+  @param[in] Buffer           The new content of the run.
+  @param[in] Length           The run length, multiple of 4KB.
+  @param[in] VerifyBuffer     Scratch buffer of at least Length bytes.
+
+  @retval  EFI_SUCCESS        Run updated and verified.
+  @retval  others             Error happening when updating.
+**/
+STATIC
+EFI_STATUS
+UpdateDirtyRun (
+  IN  UINT64    Address,
+  IN  UINT8     *Buffer,
+  IN  UINT32    Length,
+  IN  UINT8     *VerifyBuffer
+  )
+{
+  EFI_STATUS    Status;
+
+  //
+  // A 64KB aligned, 64KB long erase request is issued as a single block
+  // erase by the SPI driver, anything else falls back to 4KB sector erase.
+  //
+  Status = BootMediaErase (Address, Length);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "ERROR: in BootMediaErase. Status = 0x%x\n", Status));
+    return Status;
+  }
+
+  Status = BootMediaWrite (Address, Length, Buffer);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "ERROR: in BootDeviceWrite. Status = 0x%x\n", Status));
+    return Status;
+  }
+
+  //
+  // Only the programmed run needs to be read back, untouched sectors
+  // were already compared against the new image.
+  //
+  Status = BootMediaRead (Address, Length, VerifyBuffer);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Verify BootMediaRead failed.  readaddr: 0x%llx, Status = 0x%x\n", Address, Status));
+    return Status;
+  }
+
+  if (CompareMem (Buffer, VerifyBuffer, Length) != 0) {
+    DEBUG ((DEBUG_ERROR, "Verify Error !\n"));
+    return EFI_DEVICE_ERROR;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Update a region block.
 
-  This is the acture function to update boot meia. It will erase boot device,
-  write new data to boot device, and verify the written data.
+  This is the acture function to update boot meia. The block is processed
+  in 64KB aligned windows. For each window the current flash content is read
+  once and compared against the new data at 4KB sector granularity. Unchanged
+  sectors are skipped, consecutive dirty sectors are erased, written and
+  verified together, and a mostly dirty window is updated with one 64KB
+  block erase instead of multiple 4KB sector erases.
 
   @param[in] Address          The boot media address to be update.
   @param[in] Buffer           The source buffer to write to the boot media.
@@ -451,14 +512,17 @@ UpdateRegionBlock (
   EFI_STATUS    Status;
   UINT8         *ReadBuffer;
   UINT8         *VerifyBuffer;
-  UINT32        Count;
-  UINT32        BlockLen;
-  UINT32        WriteSize;
-  UINT8         *WriteBuffer;
   UINT8         *Src;
-
-  ReadBuffer = NULL;
-  VerifyBuffer = NULL;
+  UINT64        WinAddr;
+  UINT32        WinLen;
+  UINT32        ReadLen;
+  UINT32        Count;
+  UINT32        Offset;
+  UINT32        SectorLen;
+  UINT32        DirtyMask;
+  UINT32        Sector;
+  UINT32        RunStart;
+  UINT32        SectorCount;
 
   if (Length == 0) {
     return EFI_SUCCESS;
@@ -469,103 +533,99 @@ UpdateRegionBlock (
     return EFI_INVALID_PARAMETER;
   }
 
-  ReadBuffer = AllocatePages (EFI_SIZE_TO_PAGES (SIZE_4KB));
+  ReadBuffer = AllocatePages (EFI_SIZE_TO_PAGES (SIZE_64KB));
   if (ReadBuffer == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
 
-  VerifyBuffer = AllocatePages (EFI_SIZE_TO_PAGES (SIZE_4KB));
+  VerifyBuffer = AllocatePages (EFI_SIZE_TO_PAGES (SIZE_64KB));
   if (VerifyBuffer == NULL) {
-    FreePages (ReadBuffer, EFI_SIZE_TO_PAGES (SIZE_4KB));
+    FreePages (ReadBuffer, EFI_SIZE_TO_PAGES (SIZE_64KB));
     return EFI_OUT_OF_RESOURCES;
   }
 
-  BlockLen   = SIZE_4KB;
-  Src = (UINT8 *)Buffer;
+  Status = EFI_SUCCESS;
+  Src    = (UINT8 *)Buffer;
 
-  //
-  // Read, compare, erase, write, read, compare
-  //
-  for (Count = 0; Count < Length; Count += BlockLen) {
+  for (Count = 0; Count < Length; Count += WinLen) {
     //
-    // If updating region less than 4K bytes,
-    // adjust the block length to size remaining, i.e less than 4k
+    // Window ends at the next 64KB boundary or at the end of the block
     //
-    if (Count + BlockLen > Length) {
-      BlockLen = Length - Count;
+    WinAddr = Address + Count;
+    WinLen  = SIZE_64KB - (UINT32)(WinAddr & (SIZE_64KB - 1));
+    if (Count + WinLen > Length) {
+      WinLen = Length - Count;
     }
 
     // Partial tail update still needs full 4KB erase granularity.
     // Preserve trailing bytes in the same erase block to avoid corrupting
     // adjacent data outside the requested update range.
-    if (BlockLen < SIZE_4KB) {
-      Status = BootMediaRead(Address + Count, SIZE_4KB, ReadBuffer);
-    } else {
-      Status = BootMediaRead(Address + Count, BlockLen, ReadBuffer);
-    }
+    ReadLen = ALIGN_VALUE (WinLen, SIZE_4KB);
+    Status  = BootMediaRead (WinAddr, ReadLen, ReadBuffer);
     if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "BootMediaRead.  readaddr: 0x%llx, Status = 0x%x\n", Address + Count, Status));
+      DEBUG ((DEBUG_ERROR, "BootMediaRead.  readaddr: 0x%llx, Status = 0x%x\n", WinAddr, Status));
       goto End;
     }
 
-    if (CompareMem (Src + Count, ReadBuffer, BlockLen) == 0) {
-      DEBUG ((DEBUG_INIT, "."));
-      continue;
-    }
-
-    if (BlockLen < SIZE_4KB) {
-      CopyMem (ReadBuffer, Src + Count, BlockLen);
-      WriteBuffer = ReadBuffer;
-      WriteSize   = SIZE_4KB;
-    } else {
-      WriteBuffer = Src + Count;
-      WriteSize   = BlockLen;
-    }
-
     //
-    // Erase the boot media
-    // Block length for erase is always 4K bytes
+    // Build the dirty sector map of this window
     //
-    DEBUG ((DEBUG_INIT, "x"));
-    Status = BootMediaErase (Address + Count,  SIZE_4KB);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "ERROR: in BootMediaErase. Status = 0x%x\n", Status));
-      goto End;
+    DirtyMask   = 0;
+    SectorCount = ReadLen / SIZE_4KB;
+    for (Sector = 0; Sector < SectorCount; Sector++) {
+      Offset    = Sector * SIZE_4KB;
+      SectorLen = MIN (SIZE_4KB, WinLen - Offset);
+      if (CompareMem (Src + Count + Offset, ReadBuffer + Offset, SectorLen) != 0) {
+        DirtyMask |= (1 << Sector);
+      } else {
+        DEBUG ((DEBUG_INIT, "."));
+      }
     }
 
-    //
-    // Write to the boot media
-    //
-    Status = BootMediaWrite (Address + Count, WriteSize, WriteBuffer);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "ERROR: in BootDeviceWrite. Status = 0x%x\n", Status));
-      goto End;
+    if (DirtyMask == 0) {
+      continue;
     }
 
     //
-    // Verify the written data
+    // ReadBuffer now holds the desired flash content for the whole window
     //
-    Status = BootMediaRead (Address + Count, WriteSize, VerifyBuffer);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "Verify BootMediaRead failed.  readaddr: 0x%llx, Status = 0x%x\n", Address + Count, Status));
-      goto End;
+    CopyMem (ReadBuffer, Src + Count, WinLen);
+
+    if ((ReadLen == SIZE_64KB) &&
+        (BitFieldCountOnes32 (DirtyMask, 0, 31) >= FWU_BLOCK_ERASE_THRESHOLD)) {
+      DEBUG ((DEBUG_INIT, "X"));
+      Status = UpdateDirtyRun (WinAddr, ReadBuffer, SIZE_64KB, VerifyBuffer);
+      if (EFI_ERROR (Status)) {
+        goto End;
+      }
+      continue;
     }
 
-    if (CompareMem (WriteBuffer, VerifyBuffer, WriteSize) != 0) {
-      DEBUG ((DEBUG_ERROR, "Verify Error !\n"));
-      Status = EFI_DEVICE_ERROR;
-      goto End;
+    //
+    // Coalesce consecutive dirty sectors into a single erase/write/verify
+    //
+    Sector = 0;
+    while (Sector < SectorCount) {
+      if ((DirtyMask & (1 << Sector)) == 0) {
+        Sector++;
+        continue;
+      }
+      RunStart = Sector;
+      while ((Sector < SectorCount) && ((DirtyMask & (1 << Sector)) != 0)) {
+        DEBUG ((DEBUG_INIT, "x"));
+        Sector++;
+      }
+      Offset = RunStart * SIZE_4KB;
+      Status = UpdateDirtyRun (WinAddr + Offset, ReadBuffer + Offset, (Sector - RunStart) * SIZE_4KB, VerifyBuffer);
+      if (EFI_ERROR (Status)) {
+        goto End;
+      }
     }
   }
 
 End:
-  if (VerifyBuffer != NULL) {
-    FreePages (VerifyBuffer, EFI_SIZE_TO_PAGES (SIZE_4KB));
-  }
-
-  if (ReadBuffer != NULL) {
-    FreePages (ReadBuffer, EFI_SIZE_TO_PAGES (SIZE_4KB));
-  }
+  FreePages (VerifyBuffer, EFI_SIZE_TO_PAGES (SIZE_64KB));
+  FreePages (ReadBuffer, EFI_SIZE_TO_PAGES (SIZE_64KB));
 
   return Status;
 }
@@ -594,9 +654,11 @@ UpdateBootRegion (
   UINT32        UpdatedSize;
   UINT64        UpdateAddress;
   UINT8         *Buffer;
+  UINT32        ElapsedMs;
+  UINT32        RemainMs;
 
   //
-  // Here write 64KB every time in order to show update process.
+  // Here write up to 64KB every time in order to show update process.
   //
   UpdateAddress   = UpdateRegion->ToUpdateAddress;
   Buffer          = UpdateRegion->SourceAddress;
@@ -606,10 +668,13 @@ UpdateBootRegion (
     if (UpdateRegion->UpdateSize < SIZE_4KB) {
       UpdateBlockSize = UpdateRegion->UpdateSize;
     } else {
-      if (UpdatedSize + SIZE_64KB > UpdateRegion->UpdateSize) {
+      //
+      // Keep the chunks 64KB aligned so that UpdateRegionBlock can use
+      // block erase on fully covered windows.
+      //
+      UpdateBlockSize = SIZE_64KB - (UINT32)(UpdateAddress & (SIZE_64KB - 1));
+      if (UpdatedSize + UpdateBlockSize > UpdateRegion->UpdateSize) {
         UpdateBlockSize = UpdateRegion->UpdateSize - UpdatedSize;
-      } else {
-        UpdateBlockSize = SIZE_64KB;
       }
     }
     ConsolePrint ("Updating 0x%08llx, Size:0x%06x\n", UpdateAddress, UpdateBlockSize);
@@ -621,7 +686,15 @@ UpdateBootRegion (
     UpdateAddress += UpdateBlockSize;
     Buffer        += UpdateBlockSize;
     UpdatedSize   += UpdateBlockSize;
-    ConsolePrint ("\nFinished   %3d%%\n", (WrittenSize + UpdatedSize) * 100 / TotalSize);
+
+    //
+    // Estimate the remaining time from the average throughput so far
+    //
+    ElapsedMs = (UINT32)DivU64x32 (GetTimeInNanoSecond (GetPerformanceCounter () - mFwuPartitionStartTick), 1000000);
+    RemainMs  = (UINT32)DivU64x32 (MultU64x32 (ElapsedMs, TotalSize - (WrittenSize + UpdatedSize)), WrittenSize + UpdatedSize);
+    ConsolePrint ("\nFinished   %3d%%, elapsed %d.%03ds, remaining ~%ds\n",
+                  (WrittenSize + UpdatedSize) * 100 / TotalSize,
+                  ElapsedMs / 1000, ElapsedMs % 1000, (RemainMs + 999) / 1000);
   }
 
   return EFI_SUCCESS;
@@ -660,6 +733,7 @@ UpdateBootPartition (
   }
 
   WrittenSize = 0;
+  mFwuPartitionStartTick = GetPerformanceCounter ();
   for (Index = 0; Index < UpdatePartition->RegionCount; Index++) {
     // Adjust the offset to be relative to BIOS region start
     CopyMem (&TempRegion, &UpdatePartition->FwRegion[Index], sizeof(FIRMWARE_UPDATE_REGION));
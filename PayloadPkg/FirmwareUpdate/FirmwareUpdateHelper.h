@@ -30,6 +30,12 @@ typedef struct {
 
 #define PAD_BYTE  0xFF
 
+//
+// Minimum number of dirty 4KB sectors in a 64KB window to update the
+// whole window with a single 64KB block erase.
+//
+#define FWU_BLOCK_ERASE_THRESHOLD  4
+
 /**
   Update a region block.
 
@@ -9,6 +9,7 @@
 
 #include <Protocol/MpService.h>
 #include <Guid/MpCpuTaskInfoHob.h>
+#include <Library/CpuTaskGroupLib.h>
 
 /**
   Get processor info pointer for all CPUs.
@@ -68,4 +69,46 @@ RunCpuTask (
   IN  UINT64         Argument
   );
 
+/**
+  Run a group of tasks on the BSP and all ready APs.
+
+  The APs are shared with RunCpuTask (), only the ones in EnumCpuReady state
+  take part. See CpuTaskGroupRun () for details.
+
+  @param[in]  TaskCount   Number of tasks to run.
+  @param[in]  TaskFunc    Function to run for each task index.
+  @param[in]  Context     Context passed to every TaskFunc call.
+
+  @retval EFI_INVALID_PARAMETER   TaskFunc is NULL.
+  @retval EFI_SUCCESS             All tasks completed.
+
+**/
+EFI_STATUS
+EFIAPI
+RunCpuTaskGroup (
+  IN  UINT32               TaskCount,
+  IN  CPU_GROUP_TASK_FUNC  TaskFunc,
+  IN  VOID                *Context
+  );
+
+/**
+  Fill a large buffer with a byte value using the BSP and all ready APs.
+
+  Only the APs in EnumCpuReady state take part. See CpuTaskGroupSetMem () for details.
+
+  @param[out] Buffer      Buffer to fill.
+  @param[in]  Length      Number of bytes to fill.
+  @param[in]  Value       Value to fill the buffer with.
+
+  @retval     Buffer
+
+**/
+VOID *
+EFIAPI
+CpuSetMem (
+  OUT VOID                *Buffer,
+  IN  UINTN                Length,
+  IN  UINT8                Value
+  );
+
 #endif
@@ -106,6 +106,28 @@ GetPayloadReservedRamRegion (
   UINT64  *Size
   );
 
+/**
+  Returns the boot image cache region.
+
+  The cache takes the bottom PcdBootImageCacheSize bytes of the payload
+  reserved memory region, so it stays at the same address across warm
+  resets and is reported to the OS as reserved memory.
+
+  @param[out] Base  Base address of the boot image cache region.
+  @param[out] Size  Size of the boot image cache region.
+
+  @retval RETURN_SUCCESS        The boot image cache region is available.
+  @retval RETURN_UNSUPPORTED    The boot image cache is disabled or does not fit.
+  @retval RETURN_NOT_FOUND      Payload reserved memory region not found.
+
+**/
+RETURN_STATUS
+EFIAPI
+GetBootImageCacheRegion (
+  UINT64  *Base,
+  UINT64  *Size
+  );
+
 /**
   Returns the timestamps data.
 
@@ -54,6 +54,7 @@ PayloadInit (
   UINT32                    HeapSize;
   UINT64                    RsvdBase;
   UINT64                    RsvdSize;
+  UINT64                    CacheSize;
   UINT32                    DmaBase;
   UINT32                    DmaSize;
   UINT32                    StackBase;
@@ -72,6 +73,8 @@ PayloadInit (
   // |   Reserved memory for Slimboot core        |
   // +--------------------------------------------+ RsvdBase + RsvdSize
   // |   Reserved memory for Payload              |
+  // +--------------------------------------------+ RsvdBase + CacheSize
+  // |   + Boot image cache (optional)            |
   // +--------------------------------------------+ RsvdBase
   // |   + DMA buffer                             |
   // +--------------------------------------------+ DmaBase
@@ -86,6 +89,11 @@ PayloadInit (
   GetPayloadReservedRamRegion (&RsvdBase, &RsvdSize);
   ASSERT ((RsvdBase & EFI_PAGE_MASK) == 0);
 
+  // Keep the boot image cache out of the reserved memory pool
+  if (GetBootImageCacheRegion (NULL, &CacheSize) != RETURN_SUCCESS) {
+    CacheSize = 0;
+  }
+
   if (FeaturePcdGet (PcdDmaProtectionEnabled)) {
     DmaSize = ALIGN_UP (PcdGet32 (PcdDmaBufferSize), EFI_PAGE_SIZE);
   } else {
@@ -105,8 +113,8 @@ PayloadInit (
   MemoryRanges[0].BaseAddress   = HeapBase;
   MemoryRanges[0].NumberOfPages = EFI_SIZE_TO_PAGES (HeapSize);
   MemoryRanges[0].Type          = EfiBootServicesData;
-  MemoryRanges[1].BaseAddress   = RsvdBase;
-  MemoryRanges[1].NumberOfPages = EFI_SIZE_TO_PAGES ((UINT32)RsvdSize);
+  MemoryRanges[1].BaseAddress   = RsvdBase + CacheSize;
+  MemoryRanges[1].NumberOfPages = EFI_SIZE_TO_PAGES ((UINT32)(RsvdSize - CacheSize));
   MemoryRanges[1].Type          = EfiReservedMemoryType;
   MemoryRanges[2].BaseAddress   = DmaBase;
   MemoryRanges[2].NumberOfPages = EFI_SIZE_TO_PAGES (DmaSize);
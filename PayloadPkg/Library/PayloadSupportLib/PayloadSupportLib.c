@@ -237,6 +237,61 @@ GetPayloadReservedRamRegion (
   return Status;
 }
 
+/**
+  Returns the boot image cache region.
+
+  The cache takes the bottom PcdBootImageCacheSize bytes of the payload
+  reserved memory region, so it stays at the same address across warm
+  resets and is reported to the OS as reserved memory.
+
+  @param[out] Base  Base address of the boot image cache region.
+  @param[out] Size  Size of the boot image cache region.
+
+  @retval RETURN_SUCCESS        The boot image cache region is available.
+  @retval RETURN_UNSUPPORTED    The boot image cache is disabled or does not fit.
+  @retval RETURN_NOT_FOUND      Payload reserved memory region not found.
+
+**/
+RETURN_STATUS
+EFIAPI
+GetBootImageCacheRegion (
+  UINT64  *Base,
+  UINT64  *Size
+  )
+{
+  RETURN_STATUS      Status;
+  UINT64             ReservedBase;
+  UINT64             ReservedSize;
+  UINT32             CacheSize;
+
+  CacheSize = ALIGN_VALUE (FixedPcdGet32 (PcdBootImageCacheSize), EFI_PAGE_SIZE);
+  if (CacheSize == 0) {
+    return RETURN_UNSUPPORTED;
+  }
+
+  Status = GetPayloadReservedRamRegion (&ReservedBase, &ReservedSize);
+  if (RETURN_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // Keep at least one page for the payload reserved memory pool
+  //
+  if (ReservedSize <= CacheSize) {
+    return RETURN_UNSUPPORTED;
+  }
+
+  if (Base != NULL) {
+    *Base = ReservedBase;
+  }
+
+  if (Size != NULL) {
+    *Size = CacheSize;
+  }
+
+  return RETURN_SUCCESS;
+}
+
 /**
   Returns the timestamps data.
 
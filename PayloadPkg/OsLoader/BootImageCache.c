@@ -0,0 +1,394 @@
+/** @file
+  Keep loaded boot images in payload reserved memory across warm resets.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "OsLoader.h"
+
+#define BOOT_IMAGE_CACHE_SIGNATURE     SIGNATURE_32 ('B', 'I', 'M', 'C')
+
+//
+// Only raw partition container images can be cached. Their container
+// header is checked against the boot media before the cached copy is used.
+//
+#define BOOT_IMAGE_CACHE_FLAGS         LOADED_IMAGE_CONTAINER
+
+typedef struct {
+  UINT16                  Flags;
+  UINT8                   Valid;
+  UINT8                   Reserved;
+  UINT32                  Offset;
+  UINT32                  Size;
+  UINT8                   Digest[SHA256_DIGEST_SIZE];
+} BOOT_IMAGE_CACHE_ENTRY;
+
+typedef struct {
+  UINT32                  Signature;
+  UINT32                  UsedSize;
+  UINT8                   OptionDigest[SHA256_DIGEST_SIZE];
+  BOOT_IMAGE_CACHE_ENTRY  Entry[LoadImageTypeMax];
+} BOOT_IMAGE_CACHE_HDR;
+
+STATIC BOOT_IMAGE_CACHE_HDR  *mCacheHdr;
+STATIC UINT32                 mCacheSize;
+STATIC BOOLEAN                mCacheFilling;
+STATIC BOOLEAN                mCacheKeep;
+STATIC UINT32                 mCacheNextOffset;
+STATIC BOOLEAN                mCacheEntryUsed[LoadImageTypeMax];
+
+/**
+  Get the boot image cache header.
+
+  @retval  NULL                 The boot image cache is not available.
+  @retval  Others               Pointer to the boot image cache header.
+
+**/
+STATIC
+BOOT_IMAGE_CACHE_HDR *
+GetBootImageCache (
+  VOID
+  )
+{
+  UINT64                Base;
+  UINT64                Size;
+
+  if (mCacheHdr == NULL) {
+    if (FeaturePcdGet (PcdAbSlotSupportEnabled)) {
+      // Reusing images would skip the A/B slot selection and retry count update
+      return NULL;
+    }
+    if (RETURN_ERROR (GetBootImageCacheRegion (&Base, &Size))) {
+      return NULL;
+    }
+    if (Size <= sizeof (BOOT_IMAGE_CACHE_HDR)) {
+      return NULL;
+    }
+    mCacheHdr  = (BOOT_IMAGE_CACHE_HDR *)(UINTN)Base;
+    mCacheSize = (UINT32)Size;
+  }
+
+  return mCacheHdr;
+}
+
+/**
+  Check if the boot image cache content is valid for a boot option.
+
+  @param[in]  CacheHdr          Boot image cache header
+  @param[in]  OsBootOption      OS boot option to boot
+
+  @retval  TRUE                 The cache holds the images of this boot option.
+  @retval  FALSE                The cache content cannot be used.
+
+**/
+STATIC
+BOOLEAN
+IsBootImageCacheValid (
+  IN  BOOT_IMAGE_CACHE_HDR   *CacheHdr,
+  IN  OS_BOOT_OPTION         *OsBootOption
+  )
+{
+  UINT8                  Digest[SHA256_DIGEST_SIZE];
+  UINT8                  Index;
+
+  if ((CacheHdr->Signature != BOOT_IMAGE_CACHE_SIGNATURE) || (CacheHdr->UsedSize > mCacheSize)) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < LoadImageTypeMax; Index++) {
+    if ((CacheHdr->Entry[Index].Valid != 0) &&
+        ((CacheHdr->Entry[Index].Offset < sizeof (BOOT_IMAGE_CACHE_HDR)) ||
+         (CacheHdr->Entry[Index].Offset > CacheHdr->UsedSize) ||
+         (CacheHdr->Entry[Index].Size > CacheHdr->UsedSize - CacheHdr->Entry[Index].Offset))) {
+      return FALSE;
+    }
+  }
+
+  Sha256 ((CONST UINT8 *)OsBootOption, sizeof (OS_BOOT_OPTION), Digest);
+  return (CompareMem (Digest, CacheHdr->OptionDigest, sizeof (Digest)) == 0);
+}
+
+/**
+  Check if two container images have the same container header.
+
+  The container header holds the component hashes, so the same header
+  means the same image content once the image is verified.
+
+  @param[in]  Image1            First container image
+  @param[in]  Image2            Second container image
+  @param[in]  Size              Size of both images
+
+  @retval  TRUE                 The images have the same container header.
+  @retval  FALSE                The headers differ or are not valid.
+
+**/
+STATIC
+BOOLEAN
+IsSameContainerHeader (
+  IN  CONST VOID             *Image1,
+  IN  CONST VOID             *Image2,
+  IN  UINT32                  Size
+  )
+{
+  CONST CONTAINER_HDR   *ContainerHdr;
+
+  ContainerHdr = (CONST CONTAINER_HDR *)Image1;
+  if ((Size < sizeof (CONTAINER_HDR)) || (ContainerHdr->Signature != CONTAINER_BOOT_SIGNATURE) ||
+      (ContainerHdr->DataOffset < sizeof (CONTAINER_HDR)) || (ContainerHdr->DataOffset > Size)) {
+    return FALSE;
+  }
+
+  return (CompareMem (Image1, Image2, ContainerHdr->DataOffset) == 0);
+}
+
+/**
+  Check if the boot image cache holds valid images for a boot option.
+
+  The cache is only used after a warm reset. Its images are kept in reserved
+  memory so DRAM content survives, and are checked again in
+  RestoreCachedBootImage () against their digest and in
+  LoadBootImagesFromCache () against the boot media before use.
+
+  @param[in]  OsBootOption      OS boot option to boot
+
+  @retval  TRUE                 The cache holds the images of this boot option.
+  @retval  FALSE                The images need to be loaded from boot media.
+
+**/
+BOOLEAN
+FindBootImageCache (
+  IN  OS_BOOT_OPTION         *OsBootOption
+  )
+{
+  BOOT_IMAGE_CACHE_HDR  *CacheHdr;
+  OS_BOOT_OPTION_LIST   *OsBootOptionList;
+
+  CacheHdr = GetBootImageCache ();
+  if (CacheHdr == NULL) {
+    return FALSE;
+  }
+
+  OsBootOptionList = GetBootOptionList ();
+  if ((OsBootOptionList == NULL) || (OsBootOptionList->ResetReason != ResetWarm)) {
+    return FALSE;
+  }
+
+  return IsBootImageCacheValid (CacheHdr, OsBootOption);
+}
+
+/**
+  Copy a cached boot image into a loaded image.
+
+  The image is kept in the cache when it is committed again.
+
+  @param[in]       LoadImageType  Boot image type to restore.
+  @param[in, out]  LoadedImage    Loaded image to receive the image data.
+
+  @retval  EFI_SUCCESS            The image was restored from the cache.
+  @retval  EFI_NOT_FOUND          The cache has no image of this type.
+  @retval  EFI_SECURITY_VIOLATION The cached image does not match its digest.
+  @retval  EFI_OUT_OF_RESOURCES   Not enough memory.
+
+**/
+EFI_STATUS
+RestoreCachedBootImage (
+  IN      UINT8              LoadImageType,
+  IN OUT  LOADED_IMAGE      *LoadedImage
+  )
+{
+  BOOT_IMAGE_CACHE_ENTRY  *Entry;
+  UINT8                   *Buffer;
+  UINT8                    Digest[SHA256_DIGEST_SIZE];
+
+  if (!mCacheFilling || (LoadImageType >= LoadImageTypeMax)) {
+    return EFI_NOT_FOUND;
+  }
+
+  Entry = &mCacheHdr->Entry[LoadImageType];
+  if (Entry->Valid == 0) {
+    return EFI_NOT_FOUND;
+  }
+
+  Buffer = (UINT8 *) AllocatePages (EFI_SIZE_TO_PAGES (Entry->Size));
+  if (Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Check the copy that is going to be used
+  //
+  CopyMem (Buffer, (UINT8 *)mCacheHdr + Entry->Offset, Entry->Size);
+  Sha256 (Buffer, Entry->Size, Digest);
+  if (CompareMem (Digest, Entry->Digest, sizeof (Digest)) != 0) {
+    FreePages (Buffer, EFI_SIZE_TO_PAGES (Entry->Size));
+    return EFI_SECURITY_VIOLATION;
+  }
+
+  LoadedImage->Flags               = Entry->Flags;
+  LoadedImage->LoadImageType       = LoadImageType;
+  LoadedImage->ImageData.Addr      = Buffer;
+  LoadedImage->ImageData.Size      = Entry->Size;
+  LoadedImage->ImageData.AllocType = ImageAllocateTypePage;
+  mCacheEntryUsed[LoadImageType]   = TRUE;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Start filling the boot image cache.
+
+  If the cache holds images of the same boot option, they are kept as long
+  as the images loaded for this boot match them, so unchanged images are
+  not copied or hashed again. The cache becomes valid again only once
+  CommitBootImageCache () is called after the images were verified.
+
+  @param[in]  OsBootOption      OS boot option the images are loaded for
+
+**/
+VOID
+StartBootImageCache (
+  IN  OS_BOOT_OPTION         *OsBootOption
+  )
+{
+  BOOT_IMAGE_CACHE_HDR  *CacheHdr;
+
+  mCacheFilling = FALSE;
+  CacheHdr = GetBootImageCache ();
+  if (CacheHdr == NULL) {
+    return;
+  }
+
+  mCacheKeep = IsBootImageCacheValid (CacheHdr, OsBootOption);
+  if (mCacheKeep) {
+    CacheHdr->Signature = 0;
+  } else {
+    ZeroMem (CacheHdr, sizeof (BOOT_IMAGE_CACHE_HDR));
+  }
+  ZeroMem (mCacheEntryUsed, sizeof (mCacheEntryUsed));
+  mCacheNextOffset = ALIGN_VALUE (sizeof (BOOT_IMAGE_CACHE_HDR), EFI_PAGE_SIZE);
+  mCacheFilling    = TRUE;
+}
+
+/**
+  Add a boot image just loaded from boot media to the boot image cache.
+
+  It must be called before the image is parsed, since parsing replaces the
+  image data. Images are added in image type order. If an image cannot be
+  cached, the cache is not filled for this boot.
+
+  @param[in]  LoadedImage       Loaded image to add.
+
+**/
+VOID
+AddBootImageToCache (
+  IN  LOADED_IMAGE           *LoadedImage
+  )
+{
+  BOOT_IMAGE_CACHE_ENTRY  *Entry;
+  UINT8                   *CacheData;
+  UINT32                   Size;
+
+  if (!mCacheFilling) {
+    return;
+  }
+
+  Size = LoadedImage->ImageData.Size;
+  if ((LoadedImage->LoadImageType >= LoadImageTypeMax) ||
+      (LoadedImage->Flags != BOOT_IMAGE_CACHE_FLAGS) ||
+      (LoadedImage->ImageData.Addr == NULL) || (Size == 0) ||
+      (Size > mCacheSize - mCacheNextOffset)) {
+    DEBUG ((DEBUG_INFO, "Boot image type %d not cached\n", LoadedImage->LoadImageType));
+    InvalidateBootImageCache ();
+    return;
+  }
+
+  Entry     = &mCacheHdr->Entry[LoadedImage->LoadImageType];
+  CacheData = (UINT8 *)mCacheHdr + mCacheNextOffset;
+  mCacheEntryUsed[LoadedImage->LoadImageType] = TRUE;
+
+  if (mCacheKeep && (Entry->Valid != 0) && (Entry->Offset == mCacheNextOffset) && (Entry->Size == Size) &&
+      IsSameContainerHeader (LoadedImage->ImageData.Addr, CacheData, Size)) {
+    // The cached copy is still checked against its digest before it is used
+    mCacheNextOffset += ALIGN_VALUE (Size, EFI_PAGE_SIZE);
+    return;
+  }
+
+  //
+  // The images after this one move, so none of them can be kept
+  //
+  mCacheKeep    = FALSE;
+  Entry->Flags  = LoadedImage->Flags;
+  Entry->Offset = mCacheNextOffset;
+  Entry->Size   = Size;
+  CopyMem (CacheData, LoadedImage->ImageData.Addr, Size);
+  Sha256 (CacheData, Size, Entry->Digest);
+  Entry->Valid  = 1;
+
+  mCacheNextOffset += ALIGN_VALUE (Size, EFI_PAGE_SIZE);
+}
+
+/**
+  Mark the boot image cache valid for a boot option.
+
+  Called once the images added or restored since StartBootImageCache ()
+  were parsed and verified.
+
+  @param[in]  OsBootOption      OS boot option the images were loaded for
+
+**/
+VOID
+CommitBootImageCache (
+  IN  OS_BOOT_OPTION         *OsBootOption
+  )
+{
+  BOOT_IMAGE_CACHE_ENTRY  *Entry;
+  UINT32                   UsedSize;
+  UINT8                    Index;
+
+  if (!mCacheFilling) {
+    return;
+  }
+
+  if (OsBootOption->HwPart == 0xFF) {
+    // The images may come from any USB hardware partition
+    InvalidateBootImageCache ();
+    return;
+  }
+
+  //
+  // Drop the images that were not part of this boot
+  //
+  UsedSize = ALIGN_VALUE (sizeof (BOOT_IMAGE_CACHE_HDR), EFI_PAGE_SIZE);
+  for (Index = 0; Index < LoadImageTypeMax; Index++) {
+    Entry = &mCacheHdr->Entry[Index];
+    if (!mCacheEntryUsed[Index]) {
+      Entry->Valid = 0;
+    }
+    if ((Entry->Valid != 0) && (Entry->Offset + ALIGN_VALUE (Entry->Size, EFI_PAGE_SIZE) > UsedSize)) {
+      UsedSize = Entry->Offset + ALIGN_VALUE (Entry->Size, EFI_PAGE_SIZE);
+    }
+  }
+
+  mCacheFilling = FALSE;
+  mCacheHdr->UsedSize = UsedSize;
+  Sha256 ((CONST UINT8 *)OsBootOption, sizeof (OS_BOOT_OPTION), mCacheHdr->OptionDigest);
+  mCacheHdr->Signature = BOOT_IMAGE_CACHE_SIGNATURE;
+  DEBUG ((DEBUG_INFO, "Boot images cached (0x%X bytes)\n", mCacheHdr->UsedSize));
+}
+
+/**
+  Drop the boot image cache content.
+
+**/
+VOID
+InvalidateBootImageCache (
+  VOID
+  )
+{
+  mCacheFilling = FALSE;
+  if (mCacheHdr != NULL) {
+    mCacheHdr->Signature = 0;
+  }
+}
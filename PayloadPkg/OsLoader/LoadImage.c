@@ -71,6 +71,61 @@ GetBootImageFromIfwiContainer (
   return EFI_SUCCESS;
 }
 
+/**
+  Get the first block of a raw partition boot image on the boot media.
+
+  @param[in]  BootOption      Current boot option
+  @param[in]  LoadImageType   Boot image type
+  @param[in]  HwPartHandle    Hardware partition handle
+  @param[out] StartLba        Absolute LBA of the image on the hardware partition
+
+  @retval  EFI_SUCCESS        StartLba is set.
+  @retval  Others             The logical partition could not be found.
+**/
+STATIC
+EFI_STATUS
+GetRawImageStartLba (
+  IN  OS_BOOT_OPTION         *BootOption,
+  IN  UINT8                   LoadImageType,
+  IN  EFI_HANDLE              HwPartHandle,
+  OUT EFI_LBA                *StartLba
+  )
+{
+  EFI_STATUS                 Status;
+  LOGICAL_BLOCK_DEVICE       LogicBlkDev;
+  EFI_LBA                    LbaAddr;
+  UINT8                      SwPart;
+
+  SwPart   = BootOption->Image[LoadImageType].LbaImage.SwPart;
+  LbaAddr  = BootOption->Image[LoadImageType].LbaImage.LbaAddr;
+
+  //
+  // The image_B partition number, is image_A partition number + 1
+  // They share same LBA offset address.
+  //
+  if ((BootOption->BootFlags & LOAD_IMAGE_FROM_BACKUP) != 0) {
+    if ((LoadImageType == BOOT_FLAGS_PREOS)
+      || (LoadImageType == LoadImageTypeNormal)) {
+      SwPart++;
+    }
+  }
+
+  DEBUG ((DEBUG_INFO, "Load image from SwPart (0x%x), LbaAddr(0x%llx)\n", SwPart, LbaAddr));
+  if (SwPart != 0xFF) {
+    Status = GetLogicalPartitionInfo (SwPart, HwPartHandle, &LogicBlkDev);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_INFO, "Get logical partition error - %r\n", Status));
+      return Status;
+    }
+  } else {
+    DEBUG ((DEBUG_INFO, "SwPart is 0xFF, LbaAddr will be treated as an absolute LBA\n"));
+    LogicBlkDev.StartBlock = 0;
+  }
+
+  *StartLba = LogicBlkDev.StartBlock + LbaAddr;
+  return EFI_SUCCESS;
+}
+
 /**
   Get Boot image from raw partition
 
@@ -96,14 +151,12 @@ GetBootImageFromRawPartition (
   DEVICE_BLOCK_INFO          BlockInfo;
   VOID                       *Buffer;
   UINTN                      ImageSize;
-  LOGICAL_BLOCK_DEVICE       LogicBlkDev;
   UINTN                      AlignedHeaderSize;
   UINTN                      AlignedImageSize;
   UINTN                      AlignedHeaderBlkCnt;
   UINT32                     BlockSize;
   VOID                      *BlockData;
   EFI_LBA                    LbaAddr;
-  UINT8                      SwPart;
   UINT64                     Address;
   CONTAINER_HDR             *ContainerHdr;
 
@@ -113,30 +166,9 @@ GetBootImageFromRawPartition (
     BootOption->Image[LoadedImage->LoadImageType].LbaImage.SwPart = 0xFF;
   }
 
-  SwPart   = BootOption->Image[LoadedImage->LoadImageType].LbaImage.SwPart;
-  LbaAddr  = BootOption->Image[LoadedImage->LoadImageType].LbaImage.LbaAddr;
-
-  //
-  // The image_B partition number, is image_A partition number + 1
-  // They share same LBA offset address.
-  //
-  if ((BootOption->BootFlags & LOAD_IMAGE_FROM_BACKUP) != 0) {
-    if ((LoadedImage->LoadImageType == BOOT_FLAGS_PREOS)
-      || (LoadedImage->LoadImageType == LoadImageTypeNormal)) {
-      SwPart++;
-    }
-  }
-
-  DEBUG ((DEBUG_INFO, "Load image from SwPart (0x%x), LbaAddr(0x%llx)\n", SwPart, LbaAddr));
-  if (SwPart != 0xFF) {
-    Status = GetLogicalPartitionInfo (SwPart, LoadedImage->HwPartHandle, &LogicBlkDev);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_INFO, "Get logical partition error - %r\n", Status));
-      return Status;
-    }
-  } else {
-    DEBUG ((DEBUG_INFO, "SwPart is 0xFF, LbaAddr will be treated as an absolute LBA\n"));
-    LogicBlkDev.StartBlock = 0;
+  Status = GetRawImageStartLba (BootOption, LoadedImage->LoadImageType, LoadedImage->HwPartHandle, &LbaAddr);
+  if (EFI_ERROR (Status)) {
+    return Status;
   }
 
   Status = MediaGetMediaInfo (BootOption->HwPart, &BlockInfo);
@@ -158,7 +190,7 @@ GetBootImageFromRawPartition (
     return EFI_OUT_OF_RESOURCES;
   }
 
-  Address =  LogicBlkDev.StartBlock + LbaAddr;
+  Address = LbaAddr;
 
   Status = MediaReadBlocks (
              BootOption->HwPart,
@@ -218,7 +250,7 @@ GetBootImageFromRawPartition (
   //
   // Read the rest of the Container image into the buffer
   //
-  Address =  LogicBlkDev.StartBlock + LbaAddr + AlignedHeaderBlkCnt;
+  Address = LbaAddr + AlignedHeaderBlkCnt;
 
   if (AlignedImageSize <= AlignedHeaderSize) {
     DEBUG((DEBUG_ERROR, "Invalid image size (0x%x) from header, which is smaller than header size (0x%x)\n", AlignedImageSize, AlignedHeaderSize));
@@ -248,6 +280,72 @@ GetBootImageFromRawPartition (
   return EFI_SUCCESS;
 }
 
+/**
+  Check a boot image restored from the boot image cache against the boot media.
+
+  The container header is read again from the raw partition and compared
+  with the cached copy. The header holds the component hashes and the
+  container signature, so any change of the image on the media changes it.
+
+  @param[in]  BootOption      Current boot option
+  @param[in]  HwPartHandle    Hardware partition handle
+  @param[in]  LoadedImage     Loaded image restored from the cache
+
+  @retval  EFI_SUCCESS        The image on the media has the same header.
+  @retval  EFI_NOT_FOUND      The image on the media has changed.
+  @retval  Others             The image header could not be read.
+**/
+STATIC
+EFI_STATUS
+CheckCachedBootImage (
+  IN  OS_BOOT_OPTION         *BootOption,
+  IN  EFI_HANDLE              HwPartHandle,
+  IN  LOADED_IMAGE           *LoadedImage
+  )
+{
+  EFI_STATUS                 Status;
+  DEVICE_BLOCK_INFO          BlockInfo;
+  EFI_LBA                    LbaAddr;
+  CONTAINER_HDR             *ContainerHdr;
+  UINT8                     *BlockData;
+  UINT32                     HeaderSize;
+  UINTN                      AlignedHeaderSize;
+
+  ContainerHdr = (CONTAINER_HDR *)LoadedImage->ImageData.Addr;
+  HeaderSize   = ContainerHdr->DataOffset;
+  if ((LoadedImage->ImageData.Size < sizeof (CONTAINER_HDR)) ||
+      (ContainerHdr->Signature != CONTAINER_BOOT_SIGNATURE) ||
+      (HeaderSize < sizeof (CONTAINER_HDR)) || (HeaderSize > LoadedImage->ImageData.Size)) {
+    return EFI_NOT_FOUND;
+  }
+
+  Status = GetRawImageStartLba (BootOption, LoadedImage->LoadImageType, HwPartHandle, &LbaAddr);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = MediaGetMediaInfo (BootOption->HwPart, &BlockInfo);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  AlignedHeaderSize = ALIGN_VALUE (HeaderSize, BlockInfo.BlockSize);
+  BlockData = AllocatePages (EFI_SIZE_TO_PAGES (AlignedHeaderSize));
+  if (BlockData == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = MediaReadBlocks (BootOption->HwPart, LbaAddr, AlignedHeaderSize, BlockData);
+  if (!EFI_ERROR (Status)) {
+    if (CompareMem (BlockData, ContainerHdr, HeaderSize) != 0) {
+      Status = EFI_NOT_FOUND;
+    }
+  }
+  FreePages (BlockData, EFI_SIZE_TO_PAGES (AlignedHeaderSize));
+
+  return Status;
+}
+
 /**
   Get Boot image from File System
 
@@ -356,6 +454,15 @@ GetBootImageFromFs (
   LoadedImage->ImageData.Addr = Image;
   LoadedImage->ImageData.Size = (UINT32)ImageSize;
   LoadedImage->ImageData.AllocType = ImageAllocateTypePage;
+  if (((LoadedImage->Flags & LOADED_IMAGE_RUN_EXTRA) == 0) && IsLz4Frame (Image, ImageSize)) {
+    Status = DecompressLz4Frame (&LoadedImage->ImageData);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_INFO, "Decompress file '%a' failed, Status = %r\n", FileName, Status));
+      FreeImageData (&LoadedImage->ImageData);
+      goto Done;
+    }
+    Image = LoadedImage->ImageData.Addr;
+  }
   if ( *((UINT32 *) Image) == CONTAINER_BOOT_SIGNATURE ) {
     LoadedImage->Flags      |= LOADED_IMAGE_CONTAINER;
   }
@@ -443,6 +550,13 @@ LoadLinuxFile (
     ImageData->Addr = FileBuffer;
     ImageData->Size = (UINT32)FileSize;
     ImageData->AllocType = ImageAllocateTypePage;
+    if (IsLz4Frame (FileBuffer, FileSize)) {
+      Status = DecompressLz4Frame (ImageData);
+      DEBUG ((DEBUG_INFO, "Decompress file %a: %r\n", Ptr, Status));
+      if (EFI_ERROR (Status)) {
+        FreeImageData (ImageData);
+      }
+    }
   } else {
     if (FileBuffer != NULL) {
       FreePages (FileBuffer, EFI_SIZE_TO_PAGES(FileSize));
@@ -837,6 +951,7 @@ LoadBootImages (
   UINT8                      Index;
   CONTAINER_IMAGE           *ContainerImage;
   EFI_HANDLE                 FsHandle;
+  BOOLEAN                    RawImage;
 
   ASSERT (OsBootOption != NULL);
 
@@ -849,6 +964,8 @@ LoadBootImages (
   }
   LoadedImagesInfo->Signature = LOADED_IMAGES_INFO_SIGNATURE;
 
+  StartBootImageCache (OsBootOption);
+
   for (Index = 0; Index < LoadImageTypeMax; Index++) {
     if ((Index == LoadImageTypePreOs) && ((BootFlags & BOOT_FLAGS_PREOS) == 0)) {
       continue;
@@ -875,9 +992,11 @@ LoadBootImages (
     // Load Boot Image from FS or RAW partition
     //
     ContainerImage = &BootImage[Index].ContainerImage;
+    RawImage = FALSE;
     if ((ContainerImage->Indicate == '!') && (ContainerImage->BackSlash == '/')) {
       Status = GetBootImageFromIfwiContainer (OsBootOption, LoadedImage);
     } else if (BootImage[Index].LbaImage.Valid == 1) {
+      RawImage = TRUE;
       Status = GetBootImageFromRawPartition (OsBootOption, LoadedImage);
     } else {
       Status = GetBootImageFromFs (HwPartHandle, OsBootOption, LoadedImage);
@@ -885,6 +1004,17 @@ LoadBootImages (
 
     DEBUG ((DEBUG_INFO, "LoadBootImage ImageType-%d %r\n", Index, Status));
     LoadedImagesInfo->LoadedImageList[Index] = LoadedImage;
+    if (!EFI_ERROR (Status)) {
+      //
+      // Only raw partition images can be checked against the boot media
+      // when they are restored from the cache
+      //
+      if (RawImage) {
+        AddBootImageToCache (LoadedImage);
+      } else {
+        InvalidateBootImageCache ();
+      }
+    }
 
     if (EFI_ERROR (Status)) {
       if (FixedPcdGet8 (PcdExtraImageSupportEnabled) && (Index >= LoadImageTypeExtra0)) {
@@ -904,6 +1034,7 @@ LoadBootImages (
   //
   if (DebugCodeEnabled () || !FeaturePcdGet (PcdVerifiedBootEnabled)) {
     if (EFI_ERROR (Status) && (HwPartHandle != NULL)) {
+      InvalidateBootImageCache ();
       // Free loaded images previously, but keep LoadedImagesInfo structure
       UnloadBootImages ((EFI_HANDLE)(UINTN)LoadedImagesInfo, TRUE);
       LoadedImage = LoadedImagesInfo->LoadedImageList[LoadImageTypeNormal];
@@ -946,3 +1077,90 @@ LoadBootImages (
 
   return Status;
 }
+
+/**
+  Load boot images from the boot image cache.
+
+  The cache stays invalid while its images are in use. It is committed
+  again once the images were verified, or filled again by a boot from the
+  boot media if they cannot be used.
+
+  @param[in]  OsBootOption        Current boot option
+  @param[in]  HwPartHandle        Hardware partition handle
+  @param[out] LoadedImageHandle   Loaded Image handle
+
+  @retval     EFI_SUCCESS         The images were loaded from the cache.
+  @retval     EFI_NOT_FOUND       The cache does not hold the images of this boot option.
+  @retval     EFI_VOLUME_CHANGED  The images on the boot media have changed.
+  @retval     Others              A cached image could not be used.
+**/
+EFI_STATUS
+EFIAPI
+LoadBootImagesFromCache (
+  IN  OS_BOOT_OPTION  *OsBootOption,
+  IN  EFI_HANDLE       HwPartHandle,
+  OUT EFI_HANDLE      *LoadedImageHandle
+  )
+{
+  LOADED_IMAGES_INFO        *LoadedImagesInfo;
+  LOADED_IMAGE              *LoadedImage;
+  EFI_STATUS                 Status;
+  UINT8                      Index;
+
+  *LoadedImageHandle = NULL;
+  if (!FindBootImageCache (OsBootOption)) {
+    return EFI_NOT_FOUND;
+  }
+  StartBootImageCache (OsBootOption);
+
+  LoadedImagesInfo = (LOADED_IMAGES_INFO *)AllocateZeroPool (sizeof (LOADED_IMAGES_INFO));
+  if (LoadedImagesInfo == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  LoadedImagesInfo->Signature = LOADED_IMAGES_INFO_SIGNATURE;
+
+  Status = EFI_NOT_FOUND;
+  for (Index = 0; Index < LoadImageTypeMax; Index++) {
+    LoadedImage = (LOADED_IMAGE *)AllocateZeroPool (sizeof (LOADED_IMAGE));
+    if (LoadedImage == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      break;
+    }
+
+    Status = RestoreCachedBootImage (Index, LoadedImage);
+    if (Status == EFI_NOT_FOUND) {
+      FreePool (LoadedImage);
+      continue;
+    }
+
+    LoadedImage->HwPartHandle = HwPartHandle;
+    if (!EFI_ERROR (Status)) {
+      Status = CheckCachedBootImage (OsBootOption, HwPartHandle, LoadedImage);
+      if (Status == EFI_NOT_FOUND) {
+        // Do not mistake a changed image for a missing one
+        Status = EFI_VOLUME_CHANGED;
+      }
+    }
+
+    DEBUG ((DEBUG_INFO, "LoadBootImage ImageType-%d from cache %r\n", Index, Status));
+    LoadedImagesInfo->LoadedImageList[Index] = LoadedImage;
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  if (LoadedImagesInfo->LoadedImageList[LoadImageTypeNormal] == NULL) {
+    Status = EFI_NOT_FOUND;
+  } else if (Status == EFI_NOT_FOUND) {
+    Status = EFI_SUCCESS;
+  }
+
+  if (EFI_ERROR (Status)) {
+    InvalidateBootImageCache ();
+    UnloadBootImages ((EFI_HANDLE)(UINTN)LoadedImagesInfo, FALSE);
+    return Status;
+  }
+
+  *LoadedImageHandle = (EFI_HANDLE)(UINTN)LoadedImagesInfo;
+  return EFI_SUCCESS;
+}
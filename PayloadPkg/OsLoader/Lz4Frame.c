@@ -0,0 +1,300 @@
+/** @file
+  Decompress LZ4 frame compressed boot files.
+
+  Kernel, initrd and other files loaded from a file system may be stored as
+  standard LZ4 frames (e.g. 'lz4 -B6 vmlinuz'). When the frame uses
+  independent blocks, every block is decoded on its own, so the blocks are
+  spread over all available processors.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "OsLoader.h"
+#include <Library/Lz4CompressLib.h>
+#include <Library/SynchronizationLib.h>
+
+#define  LZ4_FRAME_MAGIC              0x184D2204
+#define  LZ4_FRAME_MIN_SIZE           (4 + 3 + 4)
+
+#define  LZ4_FLG_VERSION_MASK         0xC0
+#define  LZ4_FLG_VERSION              0x40
+#define  LZ4_FLG_BLOCK_INDEP          BIT5
+#define  LZ4_FLG_BLOCK_CHECKSUM       BIT4
+#define  LZ4_FLG_CONTENT_SIZE         BIT3
+#define  LZ4_FLG_CONTENT_CHECKSUM     BIT2
+#define  LZ4_FLG_DICT_ID              BIT0
+
+#define  LZ4_BD_BLOCK_MAX_MASK        0x70
+#define  LZ4_BLOCK_UNCOMPRESSED       BIT31
+
+typedef struct {
+  CONST UINT8     *Src;
+  UINT32           SrcSize;
+  BOOLEAN          Stored;
+  UINT32           DstSize;
+  EFI_STATUS       Status;
+} LZ4_FRAME_BLOCK;
+
+typedef struct {
+  LZ4_FRAME_BLOCK *Block;
+  UINT32           BlockCount;
+  UINT32           BlockMaxSize;
+  UINT8           *Dst;
+} LZ4_FRAME_JOB;
+
+/**
+  Check if a buffer starts with an LZ4 frame.
+
+  @param[in]  Data      Buffer to check.
+  @param[in]  Size      Size of the buffer.
+
+  @retval TRUE          The buffer holds an LZ4 frame.
+  @retval FALSE         The buffer does not hold an LZ4 frame.
+
+**/
+BOOLEAN
+IsLz4Frame (
+  IN  CONST VOID   *Data,
+  IN  UINTN         Size
+  )
+{
+  return (BOOLEAN)((Data != NULL) && (Size >= LZ4_FRAME_MIN_SIZE) &&
+                   (ReadUnaligned32 ((CONST UINT32 *)Data) == LZ4_FRAME_MAGIC));
+}
+
+/**
+  Walk the data blocks of an LZ4 frame.
+
+  @param[in]  Ptr           Pointer to the first block header.
+  @param[in]  End           End of the frame buffer.
+  @param[in]  Flags         Frame FLG byte.
+  @param[in]  BlockMaxSize  Maximum decoded size of a block.
+  @param[out] Block         Block table to fill, or NULL to only count.
+  @param[out] BlockCount    Number of data blocks in the frame.
+
+  @retval EFI_SUCCESS       The frame layout is valid.
+  @retval EFI_LOAD_ERROR    The frame is truncated or malformed.
+
+**/
+STATIC
+EFI_STATUS
+WalkLz4Blocks (
+  IN  CONST UINT8       *Ptr,
+  IN  CONST UINT8       *End,
+  IN  UINT8              Flags,
+  IN  UINT32             BlockMaxSize,
+  OUT LZ4_FRAME_BLOCK   *Block       OPTIONAL,
+  OUT UINT32            *BlockCount
+  )
+{
+  UINT32      Count;
+  UINT32      Size;
+  UINT32      Trailer;
+
+  Trailer = ((Flags & LZ4_FLG_BLOCK_CHECKSUM) != 0) ? sizeof (UINT32) : 0;
+  Count   = 0;
+  while (TRUE) {
+    if ((UINTN)(End - Ptr) < sizeof (UINT32)) {
+      return EFI_LOAD_ERROR;
+    }
+    Size = ReadUnaligned32 ((CONST UINT32 *)Ptr);
+    Ptr += sizeof (UINT32);
+    if (Size == 0) {
+      // EndMark
+      break;
+    }
+
+    if (((Size & ~LZ4_BLOCK_UNCOMPRESSED) > BlockMaxSize) ||
+        ((UINTN)(End - Ptr) < (UINTN)(Size & ~LZ4_BLOCK_UNCOMPRESSED) + Trailer)) {
+      return EFI_LOAD_ERROR;
+    }
+
+    if (Block != NULL) {
+      Block[Count].Src     = Ptr;
+      Block[Count].SrcSize = Size & ~LZ4_BLOCK_UNCOMPRESSED;
+      Block[Count].Stored  = (BOOLEAN)((Size & LZ4_BLOCK_UNCOMPRESSED) != 0);
+      Block[Count].Status  = EFI_NOT_STARTED;
+    }
+    Ptr += (Size & ~LZ4_BLOCK_UNCOMPRESSED) + Trailer;
+    Count++;
+  }
+
+  *BlockCount = Count;
+  return EFI_SUCCESS;
+}
+
+/**
+  Task group function to decode one frame block.
+
+  @param[in]  TaskIndex Index of the block to decode.
+  @param[in]  Context   Pointer to LZ4_FRAME_JOB.
+
+**/
+STATIC
+VOID
+EFIAPI
+DecodeLz4Block (
+  IN  UINT32          TaskIndex,
+  IN  VOID           *Context
+  )
+{
+  LZ4_FRAME_JOB    *Job;
+  LZ4_FRAME_BLOCK  *Block;
+  UINT8            *Dst;
+
+  Job   = (LZ4_FRAME_JOB *)Context;
+  Block = &Job->Block[TaskIndex];
+  Dst   = Job->Dst + (UINTN)TaskIndex * Job->BlockMaxSize;
+  if (Block->Stored) {
+    CopyMem (Dst, Block->Src, Block->SrcSize);
+    Block->DstSize = Block->SrcSize;
+    Block->Status  = EFI_SUCCESS;
+  } else {
+    Block->Status  = Lz4DecompressBlock (Block->Src, Block->SrcSize, Dst, Job->BlockMaxSize, &Block->DstSize);
+  }
+}
+
+/**
+  Decompress an LZ4 frame loaded from a file.
+
+  The frame must use independent blocks so that every block can be placed
+  at BlockIndex * BlockMaxSize in the destination and decoded in parallel.
+  On success the compressed buffer is freed and ImageData describes the
+  decompressed data. Block and content checksums are not verified.
+
+  @param[in, out]  ImageData      File data holding an LZ4 frame.
+
+  @retval EFI_SUCCESS             The file was decompressed.
+  @retval EFI_UNSUPPORTED         The frame uses features not supported here.
+  @retval EFI_LOAD_ERROR          The frame is malformed.
+  @retval EFI_OUT_OF_RESOURCES    Not enough memory.
+
+**/
+EFI_STATUS
+DecompressLz4Frame (
+  IN OUT IMAGE_DATA   *ImageData
+  )
+{
+  EFI_STATUS        Status;
+  CONST UINT8      *Ptr;
+  CONST UINT8      *End;
+  UINT8             Flags;
+  UINT8             Bd;
+  UINT64            ContentSize;
+  UINT64            Capacity;
+  UINT64            TotalSize;
+  LZ4_FRAME_JOB     Job;
+  UINT32            Index;
+  UINTN             AllocPages;
+  UINTN             UsedPages;
+
+  if (!IsLz4Frame (ImageData->Addr, ImageData->Size)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Ptr   = (CONST UINT8 *)ImageData->Addr + sizeof (UINT32);
+  End   = (CONST UINT8 *)ImageData->Addr + ImageData->Size;
+  Flags = Ptr[0];
+  Bd    = Ptr[1];
+  Ptr  += 2;
+
+  if (((Flags & LZ4_FLG_VERSION_MASK) != LZ4_FLG_VERSION) || ((Flags & LZ4_FLG_DICT_ID) != 0) ||
+      ((Bd & ~LZ4_BD_BLOCK_MAX_MASK) != 0) || (((Bd & LZ4_BD_BLOCK_MAX_MASK) >> 4) < 4)) {
+    DEBUG ((DEBUG_INFO, "Unsupported LZ4 frame descriptor 0x%02x 0x%02x\n", Flags, Bd));
+    return EFI_UNSUPPORTED;
+  }
+
+  if ((Flags & LZ4_FLG_BLOCK_INDEP) == 0) {
+    DEBUG ((DEBUG_INFO, "LZ4 frame with linked blocks is not supported, use 'lz4 --BI'\n"));
+    return EFI_UNSUPPORTED;
+  }
+
+  ContentSize = 0;
+  if ((Flags & LZ4_FLG_CONTENT_SIZE) != 0) {
+    if ((UINTN)(End - Ptr) < sizeof (UINT64)) {
+      return EFI_LOAD_ERROR;
+    }
+    ContentSize = ReadUnaligned64 ((CONST UINT64 *)Ptr);
+    Ptr += sizeof (UINT64);
+  }
+
+  // Skip header checksum
+  if (Ptr >= End) {
+    return EFI_LOAD_ERROR;
+  }
+  Ptr++;
+
+  ZeroMem (&Job, sizeof (Job));
+  Job.BlockMaxSize = 1 << (8 + 2 * ((Bd & LZ4_BD_BLOCK_MAX_MASK) >> 4));
+  Status = WalkLz4Blocks (Ptr, End, Flags, Job.BlockMaxSize, NULL, &Job.BlockCount);
+  if (EFI_ERROR (Status) || (Job.BlockCount == 0)) {
+    return EFI_LOAD_ERROR;
+  }
+
+  Capacity = MultU64x32 (Job.BlockCount, Job.BlockMaxSize);
+  if ((Capacity > MAX_UINT32) || (ContentSize > Capacity)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Job.Block = AllocatePool (sizeof (LZ4_FRAME_BLOCK) * Job.BlockCount);
+  if (Job.Block == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  WalkLz4Blocks (Ptr, End, Flags, Job.BlockMaxSize, Job.Block, &Job.BlockCount);
+
+  AllocPages = EFI_SIZE_TO_PAGES ((UINTN)Capacity);
+  Job.Dst    = AllocatePages (AllocPages);
+  if (Job.Dst == NULL) {
+    FreePool (Job.Block);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Blocks are independent, decode them on all idle processors
+  //
+  RunCpuTaskGroup (Job.BlockCount, DecodeLz4Block, &Job);
+
+  //
+  // Only the last block may be shorter than the block size, otherwise the
+  // data would not be contiguous at the fixed block offsets.
+  //
+  Status = EFI_SUCCESS;
+  for (Index = 0; Index < Job.BlockCount; Index++) {
+    if (EFI_ERROR (Job.Block[Index].Status)) {
+      DEBUG ((DEBUG_INFO, "LZ4 block %d decode failed\n", Index));
+      Status = EFI_LOAD_ERROR;
+      break;
+    }
+    if ((Index + 1 < Job.BlockCount) && (Job.Block[Index].DstSize != Job.BlockMaxSize)) {
+      DEBUG ((DEBUG_INFO, "LZ4 block %d is not full\n", Index));
+      Status = EFI_UNSUPPORTED;
+      break;
+    }
+  }
+
+  TotalSize = MultU64x32 (Job.BlockCount - 1, Job.BlockMaxSize) + Job.Block[Job.BlockCount - 1].DstSize;
+  if (!EFI_ERROR (Status) && ((Flags & LZ4_FLG_CONTENT_SIZE) != 0) && (TotalSize != ContentSize)) {
+    Status = EFI_LOAD_ERROR;
+  }
+  FreePool (Job.Block);
+
+  if (EFI_ERROR (Status)) {
+    FreePages (Job.Dst, AllocPages);
+    return Status;
+  }
+
+  UsedPages = EFI_SIZE_TO_PAGES ((UINTN)TotalSize);
+  if (AllocPages > UsedPages) {
+    FreePages (Job.Dst + EFI_PAGES_TO_SIZE (UsedPages), AllocPages - UsedPages);
+  }
+
+  DEBUG ((DEBUG_INFO, "LZ4 frame 0x%x -> 0x%lx bytes, %d blocks\n", ImageData->Size, TotalSize, Job.BlockCount));
+  FreeImageData (ImageData);
+  ImageData->Addr      = Job.Dst;
+  ImageData->Size      = (UINT32)TotalSize;
+  ImageData->AllocType = ImageAllocateTypePage;
+
+  return EFI_SUCCESS;
+}
@@ -11,6 +11,64 @@
 UINT8    mCurrentBoot;
 VOID    *mEntryStack;
 
+//
+// Boot devices that already failed to initialize during the current pass
+// over the boot option list. Encoded as (DevType << 8) | DevInstance.
+//
+#define  MAX_FAILED_BOOT_DEVICE    8
+STATIC UINT16   mFailedBootDevice[MAX_FAILED_BOOT_DEVICE];
+STATIC UINT8    mFailedBootDeviceCount;
+
+/**
+  Check if the boot device of a boot option already failed to initialize.
+
+  @param[in]  OsBootOption    Boot option to check.
+
+  @retval TRUE                The boot device is known to be unusable.
+  @retval FALSE               The boot device has not failed so far.
+
+**/
+STATIC
+BOOLEAN
+IsBootDeviceFailed (
+  IN  OS_BOOT_OPTION  *OsBootOption
+  )
+{
+  UINT16   Key;
+  UINT8    Index;
+
+  Key = (UINT16)((OsBootOption->DevType << 8) | OsBootOption->DevInstance);
+  for (Index = 0; Index < mFailedBootDeviceCount; Index++) {
+    if (mFailedBootDevice[Index] == Key) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Remember that the boot device of a boot option failed to initialize.
+
+  Other boot options on the same device will then be skipped instead of
+  paying the device initialization and timeout cost again.
+
+  @param[in]  OsBootOption    Boot option whose device failed.
+
+**/
+STATIC
+VOID
+SetBootDeviceFailed (
+  IN  OS_BOOT_OPTION  *OsBootOption
+  )
+{
+  if (IsBootDeviceFailed (OsBootOption) || (mFailedBootDeviceCount >= MAX_FAILED_BOOT_DEVICE)) {
+    return;
+  }
+
+  mFailedBootDevice[mFailedBootDeviceCount++] = (UINT16)((OsBootOption->DevType << 8) | OsBootOption->DevInstance);
+}
+
 /**
   Callback function to add performance measure point during component loading.
 
@@ -145,6 +203,7 @@ UpdateLoadedImage (
       // Make sure Initrd is page aligned
       //
       if (((((UINTN)File[2].Addr) & EFI_PAGE_MASK) != 0) && (File[2].Size > 0)) {
+        DEBUG ((DEBUG_INFO, "Initrd at 0x%p is not page aligned, copy it\n", File[2].Addr));
         LinuxImage->InitrdFile.Addr = AllocatePages (EFI_SIZE_TO_PAGES (File[2].Size));
         if (LinuxImage->InitrdFile.Addr == NULL) {
           return EFI_OUT_OF_RESOURCES;
@@ -1226,9 +1285,30 @@ BootOsImage (
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_INFO, "Failed to Initialize Boot Device - Type %d, Instance %d\n",
       OsBootOption->DevType, OsBootOption->DevInstance));
+    SetBootDeviceFailed (OsBootOption);
     goto Exit;
   }
 
+  //
+  // Reuse the images kept in memory by the previous boot on a warm reset
+  // if their headers still match the boot media
+  //
+  if (FindBootImageCache (OsBootOption)) {
+    Status = FindBootPartitions (OsBootOption, &HwPartHandle);
+    if (!EFI_ERROR (Status)) {
+      Status = LoadBootImagesFromCache (OsBootOption, HwPartHandle, &LoadedImageHandle);
+      DEBUG ((DEBUG_INFO, "Load boot images from cache %r\n", Status));
+    }
+    if (!EFI_ERROR (Status)) {
+      AddMeasurePoint (0x4070);
+      goto Parse;
+    }
+    if (HwPartHandle != NULL) {
+      ClosePartitions (HwPartHandle);
+      HwPartHandle = NULL;
+    }
+  }
+
 
   //
   // For USB devices, try to boot from each of them until a success or
@@ -1313,14 +1393,17 @@ BootOsImage (
     goto Exit;
   }
 
+Parse:
   //
   // Parse Boot Image
   //
   Status = ParseBootImages (OsBootOption, LoadedImageHandle);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_INFO, "Failed to Parse Boot Image\n"));
+    InvalidateBootImageCache ();
     goto Exit;
   }
+  CommitBootImageCache (OsBootOption);
 
   //
   // Setup Boot Image
@@ -1500,6 +1583,8 @@ PayloadMain (
     DEBUG_CODE_END ();
 
     // Load and run Image in order from OsImageList
+    // Devices may appear after returning from shell, so forget earlier failures
+    mFailedBootDeviceCount = 0;
     BootIdx = 0;
     CurrIdx = GetCurrentBootOption (OsBootOptionList, 0);
     while  (BootIdx < OsBootOptionList->OsBootOptionCount) {
@@ -1508,14 +1593,19 @@ PayloadMain (
 
       // Get current boot option and try boot
       CopyMem ((VOID *)&OsBootOption, (VOID *)&OsBootOptionList->OsBootOption[CurrIdx], sizeof (OS_BOOT_OPTION));
-      BootOsImage (&OsBootOption);
-
-      // De-init the current boot devices
-      // If USB keyboard console is used, don't DeInit USB yet at this moment.
-      // It will be handled just before transfering to OS.
-      if (!((OsBootOption.DevType == OsBootDeviceUsb) &&
-          ((PcdGet32 (PcdConsoleInDeviceMask) & ConsoleInUsbKeyboard) != 0))) {
-        MediaInitialize (0, DevDeinit);
+      if (IsBootDeviceFailed (&OsBootOption)) {
+        DEBUG ((DEBUG_INFO, "Skip Boot Option %d, Boot Device - Type %d, Instance %d failed already\n",
+          CurrIdx, OsBootOption.DevType, OsBootOption.DevInstance));
+      } else {
+        BootOsImage (&OsBootOption);
+
+        // De-init the current boot devices
+        // If USB keyboard console is used, don't DeInit USB yet at this moment.
+        // It will be handled just before transfering to OS.
+        if (!((OsBootOption.DevType == OsBootDeviceUsb) &&
+            ((PcdGet32 (PcdConsoleInDeviceMask) & ConsoleInUsbKeyboard) != 0))) {
+          MediaInitialize (0, DevDeinit);
+        }
       }
 
       if (OsBootOptionList->RestrictedBoot != 0) {
@@ -274,6 +274,29 @@ LoadBootImages (
   OUT EFI_HANDLE      *LoadedImageHandle
   );
 
+/**
+  Load boot images from the boot image cache.
+
+  The cache is used once: it is dropped here whether or not its images
+  can be used, and filled again by the next boot from the boot media.
+
+  @param[in]  OsBootOption        Current boot option
+  @param[in]  HwPartHandle        Hardware partition handle
+  @param[out] LoadedImageHandle   Loaded Image handle
+
+  @retval     EFI_SUCCESS         The images were loaded from the cache.
+  @retval     EFI_NOT_FOUND       The cache does not hold the images of this boot option.
+  @retval     EFI_VOLUME_CHANGED  The images on the boot media have changed.
+  @retval     Others              A cached image could not be used.
+**/
+EFI_STATUS
+EFIAPI
+LoadBootImagesFromCache (
+  IN  OS_BOOT_OPTION  *OsBootOption,
+  IN  EFI_HANDLE       HwPartHandle,
+  OUT EFI_HANDLE      *LoadedImageHandle
+  );
+
 /**
   Wrapper function to print LinuxLoader Measure Point information.
 **/
@@ -530,6 +553,136 @@ StartPreOsBooting (
   );
 
 
+/**
+  Check if a buffer starts with an LZ4 frame.
+
+  @param[in]  Data      Buffer to check.
+  @param[in]  Size      Size of the buffer.
+
+  @retval TRUE          The buffer holds an LZ4 frame.
+  @retval FALSE         The buffer does not hold an LZ4 frame.
+
+**/
+BOOLEAN
+IsLz4Frame (
+  IN  CONST VOID   *Data,
+  IN  UINTN         Size
+  );
+
+/**
+  Decompress an LZ4 frame loaded from a file.
+
+  The frame must use independent blocks so that every block can be placed
+  at BlockIndex * BlockMaxSize in the destination and decoded in parallel.
+  On success the compressed buffer is freed and ImageData describes the
+  decompressed data. Block and content checksums are not verified.
+
+  @param[in, out]  ImageData      File data holding an LZ4 frame.
+
+  @retval EFI_SUCCESS             The file was decompressed.
+  @retval EFI_UNSUPPORTED         The frame uses features not supported here.
+  @retval EFI_LOAD_ERROR          The frame is malformed.
+  @retval EFI_OUT_OF_RESOURCES    Not enough memory.
+
+**/
+EFI_STATUS
+DecompressLz4Frame (
+  IN OUT IMAGE_DATA   *ImageData
+  );
+
+/**
+  Check if the boot image cache holds valid images for a boot option.
+
+  The cache is only used after a warm reset. Its images are kept in reserved
+  memory so DRAM content survives, and are checked again in
+  RestoreCachedBootImage () against their digest and in
+  LoadBootImagesFromCache () against the boot media before use.
+
+  @param[in]  OsBootOption      OS boot option to boot
+
+  @retval  TRUE                 The cache holds the images of this boot option.
+  @retval  FALSE                The images need to be loaded from boot media.
+
+**/
+BOOLEAN
+FindBootImageCache (
+  IN  OS_BOOT_OPTION         *OsBootOption
+  );
+
+/**
+  Copy a cached boot image into a loaded image.
+
+  The image is kept in the cache when it is committed again.
+
+  @param[in]       LoadImageType  Boot image type to restore.
+  @param[in, out]  LoadedImage    Loaded image to receive the image data.
+
+  @retval  EFI_SUCCESS            The image was restored from the cache.
+  @retval  EFI_NOT_FOUND          The cache has no image of this type.
+  @retval  EFI_SECURITY_VIOLATION The cached image does not match its digest.
+  @retval  EFI_OUT_OF_RESOURCES   Not enough memory.
+
+**/
+EFI_STATUS
+RestoreCachedBootImage (
+  IN      UINT8              LoadImageType,
+  IN OUT  LOADED_IMAGE      *LoadedImage
+  );
+
+/**
+  Start filling the boot image cache.
+
+  If the cache holds images of the same boot option, they are kept as long
+  as the images loaded for this boot match them, so unchanged images are
+  not copied or hashed again. The cache becomes valid again only once
+  CommitBootImageCache () is called after the images were verified.
+
+  @param[in]  OsBootOption      OS boot option the images are loaded for
+
+**/
+VOID
+StartBootImageCache (
+  IN  OS_BOOT_OPTION         *OsBootOption
+  );
+
+/**
+  Add a boot image just loaded from boot media to the boot image cache.
+
+  It must be called before the image is parsed, since parsing replaces the
+  image data. Images are added in image type order. If an image cannot be
+  cached, the cache is not filled for this boot.
+
+  @param[in]  LoadedImage       Loaded image to add.
+
+**/
+VOID
+AddBootImageToCache (
+  IN  LOADED_IMAGE           *LoadedImage
+  );
+
+/**
+  Mark the boot image cache valid for a boot option.
+
+  Called once the images added or restored since StartBootImageCache ()
+  were parsed and verified.
+
+  @param[in]  OsBootOption      OS boot option the images were loaded for
+
+**/
+VOID
+CommitBootImageCache (
+  IN  OS_BOOT_OPTION         *OsBootOption
+  );
+
+/**
+  Drop the boot image cache content.
+
+**/
+VOID
+InvalidateBootImageCache (
+  VOID
+  );
+
 /**
   Call into an extra image entrypoint.
 
@@ -134,6 +134,7 @@ class Board(BaseBoard):
         # XCC : Max 72 physical cores (2x with hyperthreading)
         self.CPU_MAX_LOGICAL_PROCESSOR_NUMBER = 144
         self.CPU_AP_WAIT_TIME_US = 200000 # Time to wait for AP Wakeup in MicroSeconds
+        self.CPU_PACKAGE_COUNT = 0 # Package count varies per board, always wait CPU_AP_WAIT_TIME_US
 
         if self.HAVE_FIT_TABLE:
             self.FIT_ENTRY_MAX_NUM  = 17 #
@@ -72,6 +72,8 @@ class Board(BaseBoard):
         self.ENABLE_UPL_HANDOFF_FDT   = 0
 
         self.CPU_MAX_LOGICAL_PROCESSOR_NUMBER = 255
+        # Socket count is set on the QEMU command line
+        self.CPU_PACKAGE_COUNT       = 0
         self.MADT_USE_PLATFORM_LAPIC = 1
 
         # RSA2048 or RSA3072